@@ -0,0 +1,469 @@
+//============================================================================
+// Name        : CourseClient.cpp
+// Author      : Erik Olsen
+// Version     : 1.0
+// Course      : CS-300
+// Description : Client and load generator for the course query server
+//               (CourseManagement_v1.2.cpp --serve). Linux only.
+//============================================================================
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <chrono>
+#include <random>
+#include <iomanip>
+
+#include <sys/epoll.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <csignal>
+#include <cerrno>
+#include <cstring>
+
+using namespace std;
+using namespace std:: chrono;
+
+// Default socket path shared with CourseManagement_v1.2.cpp
+const string DEFAULT_SOCKET_PATH = "/tmp/abcu_courses.sock";
+
+//=============================================================================
+// Connection and Protocol Helpers
+//=============================================================================
+
+/**
+ * Connect to the course server
+ * @param socketPath Filesystem path of the server socket
+ * @return The connected socket, or -1 on failure
+ */
+int connectToServer(const string& socketPath) {
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * Send an entire buffer, retrying on partial writes
+ * A non-blocking socket that is full is waited on until it can take more
+ * @param fd The connected socket
+ * @param data The bytes to send
+ * @return True if everything was sent
+ */
+bool sendAll(int fd, const string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t written = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                pollfd writable{fd, POLLOUT, 0};
+                if (poll(&writable, 1, -1) < 0 && errno != EINTR) {
+                    return false;
+                }
+                continue;
+            }
+            return false;
+        }
+        sent += static_cast<size_t>(written);
+    }
+    return true;
+}
+
+/**
+ * Try to take one complete frame off the front of a buffer
+ * Frames are "<status> <bytes>\n<body>"; MORE frames carry a chunk of a
+ * streamed response and are followed by more frames, OK/ERR end a response
+ * @param buffer Bytes received so far; the frame is erased on success
+ * @param status Set to the frame status word
+ * @param body Set to the frame body
+ * @return True if a complete frame was available
+ */
+bool extractFrame(string& buffer, string& status, string& body) {
+    size_t newline = buffer.find('\n');
+    if (newline == string::npos) {
+        return false;
+    }
+
+    size_t space = buffer.find(' ');
+    if (space == string::npos || space > newline) {
+        return false;
+    }
+    size_t length = stoul(buffer.substr(space + 1, newline - space - 1));
+    if (buffer.size() < newline + 1 + length) {
+        return false;
+    }
+
+    status = buffer.substr(0, space);
+    body = buffer.substr(newline + 1, length);
+    buffer.erase(0, newline + 1 + length);
+    return true;
+}
+
+/**
+ * Block until one complete response has been read, joining streamed chunks
+ * @param fd The connected socket
+ * @param buffer Receive buffer carried between calls
+ * @param ok Set to whether the response was OK or ERR
+ * @param body Set to the response body
+ * @return False if the server closed the connection first
+ */
+bool readResponse(int fd, string& buffer, bool& ok, string& body) {
+    char chunk[64 * 1024];
+    string status;
+    string frame;
+    body.clear();
+    while (true) {
+        while (extractFrame(buffer, status, frame)) {
+            body += frame;
+            if (status != "MORE") {
+                ok = status == "OK";
+                return true;
+            }
+        }
+        ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+        if (received <= 0) {
+            if (received < 0 && errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        buffer.append(chunk, static_cast<size_t>(received));
+    }
+}
+
+/**
+ * Read the course numbers (first column) from a catalog CSV
+ * @param filename Path to the CSV file
+ * @return The course numbers found in the file
+ */
+vector<string> loadCourseKeys(const string& filename) {
+    vector<string> keys;
+    ifstream file(filename);
+    string line;
+    while (getline(file, line)) {
+        string key = line.substr(0, line.find(','));
+        if (!key.empty() && key.find_first_not_of(" \t\r") != string::npos) {
+            keys.push_back(key);
+        }
+    }
+    return keys;
+}
+
+//=============================================================================
+// Interactive Client
+//=============================================================================
+
+/**
+ * Send requests and print responses until end of input or QUIT
+ * @param socketPath Filesystem path of the server socket
+ * @param request A single request to send, or empty to read requests from stdin
+ * @return Process exit status
+ */
+int runClient(const string& socketPath, const string& request) {
+    int fd = connectToServer(socketPath);
+    if (fd < 0) {
+        cerr << "Error: Could not connect to " << socketPath << ": " << strerror(errno) << endl;
+        return 1;
+    }
+
+    string buffer;
+    string body;
+    bool ok = false;
+
+    if (!request.empty()) {
+        if (!sendAll(fd, request + "\n") || !readResponse(fd, buffer, ok, body)) {
+            cerr << "Error: Connection closed by server." << endl;
+            close(fd);
+            return 1;
+        }
+        (ok ? cout : cerr) << body;
+        close(fd);
+        return ok ? 0 : 1;
+    }
+
+    string line;
+    cout << "> ";
+    while (getline(cin, line)) {
+        if (!line.empty()) {
+            if (!sendAll(fd, line + "\n") || !readResponse(fd, buffer, ok, body)) {
+                cerr << "Error: Connection closed by server." << endl;
+                break;
+            }
+            cout << body;
+            if (line == "QUIT" || line == "quit") {
+                break;
+            }
+        }
+        cout << "> ";
+    }
+
+    close(fd);
+    return 0;
+}
+
+//=============================================================================
+// Load Generator
+//=============================================================================
+
+// Settings for a benchmark run
+struct BenchmarkOptions {
+    string socketPath = DEFAULT_SOCKET_PATH;
+    string keysFile;
+    size_t connections = 16;
+    size_t requests = 100000;
+    size_t depth = 8; // Pipelined requests kept in flight per connection
+    bool backgroundList = false; // Keep one extra connection issuing LIST
+};
+
+// One load-generating client connection
+struct BenchmarkConnection {
+    int fd = -1;
+    string inBuffer;
+    vector<steady_clock::time_point> inFlight; // Send times, oldest first
+    size_t inFlightHead = 0;
+};
+
+/**
+ * Drive the server with pipelined COURSE lookups from many connections
+ * and report throughput and latency percentiles. With backgroundList,
+ * one more connection requests full listings back-to-back for the whole
+ * run, showing lookup tail latency while long requests are in progress.
+ * @param options Benchmark settings
+ * @return Process exit status
+ */
+int runLoadGenerator(const BenchmarkOptions& options) {
+    vector<string> keys = loadCourseKeys(options.keysFile);
+    if (keys.empty()) {
+        cerr << "Error: No course numbers found in '" << options.keysFile << "'" << endl;
+        return 1;
+    }
+
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    vector<BenchmarkConnection> connections(options.connections);
+    for (size_t c = 0; c < connections.size(); ++c) {
+        connections[c].fd = connectToServer(options.socketPath);
+        if (connections[c].fd < 0) {
+            cerr << "Error: Could not connect to " << options.socketPath << ": " << strerror(errno) << endl;
+            return 1;
+        }
+        fcntl(connections[c].fd, F_SETFL, O_NONBLOCK);
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.u64 = c;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, connections[c].fd, &event);
+    }
+
+    // The listing connection is tagged with index connections.size() in epoll
+    int listFd = -1;
+    string listBuffer;
+    size_t listingsCompleted = 0;
+    if (options.backgroundList) {
+        listFd = connectToServer(options.socketPath);
+        if (listFd < 0) {
+            cerr << "Error: Could not connect to " << options.socketPath << ": " << strerror(errno) << endl;
+            return 1;
+        }
+        fcntl(listFd, F_SETFL, O_NONBLOCK);
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.u64 = connections.size();
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, listFd, &event);
+    }
+
+    mt19937 generator(300);
+    size_t sent = 0;
+    size_t completed = 0;
+    size_t errors = 0;
+    vector<double> latencies;
+    latencies.reserve(options.requests);
+
+    // Top a connection up to the pipeline depth with one batched write
+    auto fillPipeline = [&](BenchmarkConnection& connection) {
+        string batch;
+        auto now = steady_clock::now();
+        while (connection.inFlight.size() - connection.inFlightHead < options.depth && sent < options.requests) {
+            batch += "COURSE " + keys[generator() % keys.size()] + "\n";
+            connection.inFlight.push_back(now);
+            ++sent;
+        }
+        if (!batch.empty()) {
+            sendAll(connection.fd, batch);
+        }
+    };
+
+    auto startTime = steady_clock::now();
+    if (listFd >= 0) {
+        sendAll(listFd, "LIST\n");
+    }
+    for (auto& connection : connections) {
+        fillPipeline(connection);
+    }
+
+    vector<epoll_event> events(connections.size() + 1);
+    char chunk[64 * 1024];
+    while (completed < options.requests) {
+        int ready = epoll_wait(epollFd, events.data(), static_cast<int>(events.size()), 5000);
+        if (ready <= 0) {
+            cerr << "Error: Server stopped responding." << endl;
+            break;
+        }
+
+        for (int e = 0; e < ready; ++e) {
+            if (events[e].data.u64 == connections.size()) {
+                // Background listing: discard the output, start the next one when it ends
+                ssize_t received;
+                while ((received = recv(listFd, chunk, sizeof(chunk), 0)) > 0) {
+                    listBuffer.append(chunk, static_cast<size_t>(received));
+                }
+                string status;
+                string body;
+                while (extractFrame(listBuffer, status, body)) {
+                    if (status != "MORE") {
+                        ++listingsCompleted;
+                        sendAll(listFd, "LIST\n");
+                    }
+                }
+                continue;
+            }
+
+            BenchmarkConnection& connection = connections[events[e].data.u64];
+            ssize_t received;
+            while ((received = recv(connection.fd, chunk, sizeof(chunk), 0)) > 0) {
+                connection.inBuffer.append(chunk, static_cast<size_t>(received));
+            }
+
+            string status;
+            string body;
+            auto now = steady_clock::now();
+            while (extractFrame(connection.inBuffer, status, body)) {
+                if (status == "MORE") {
+                    continue;
+                }
+                auto sendTime = connection.inFlight[connection.inFlightHead++];
+                latencies.push_back(duration_cast<nanoseconds>(now - sendTime).count() / 1000.0);
+                errors += status == "OK" ? 0 : 1;
+                ++completed;
+            }
+            if (connection.inFlightHead == connection.inFlight.size()) {
+                connection.inFlight.clear();
+                connection.inFlightHead = 0;
+            }
+            fillPipeline(connection);
+        }
+    }
+    auto endTime = steady_clock::now();
+
+    for (auto& connection : connections) {
+        close(connection.fd);
+    }
+    if (listFd >= 0) {
+        close(listFd);
+    }
+    close(epollFd);
+
+    if (latencies.empty()) {
+        return 1;
+    }
+
+    double seconds = duration_cast<microseconds>(endTime - startTime).count() / 1000000.0;
+    sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) {
+        return latencies[min(latencies.size() - 1, static_cast<size_t>(p * latencies.size()))];
+    };
+
+    cout << "Connections:      " << options.connections << " (pipeline depth " << options.depth << ")" << endl;
+    cout << "Requests:         " << completed << " (" << errors << " errors)" << endl;
+    cout << "Elapsed:          " << fixed << setprecision(6) << seconds << " seconds" << endl;
+    cout << "Throughput:       " << fixed << setprecision(0) << completed / seconds << " requests/second" << endl;
+    cout << "Latency p50:      " << fixed << setprecision(1) << percentile(0.50) << " us" << endl;
+    cout << "Latency p90:      " << percentile(0.90) << " us" << endl;
+    cout << "Latency p99:      " << percentile(0.99) << " us" << endl;
+    cout << "Latency max:      " << latencies.back() << " us" << endl;
+    if (options.backgroundList) {
+        cout << "Background LISTs: " << listingsCompleted << " completed" << endl;
+    }
+    return errors == 0 ? 0 : 1;
+}
+
+//=============================================================================
+// Main Function
+//=============================================================================
+
+// Print the command-line usage
+void printUsage(const char* program) {
+    cout << "Usage:" << endl;
+    cout << "  " << program << " [--socket path]                 Interactive client" << endl;
+    cout << "  " << program << " [--socket path] <request...>    Send one request (e.g. COURSE CSCI300)" << endl;
+    cout << "  " << program << " --bench <file.csv> [--socket path] [--connections N]" << endl;
+    cout << "        [--requests N] [--depth N] [--background-list]" << endl;
+    cout << "                                               Pipelined lookup load generator" << endl;
+}
+
+/**
+ * Parse a count option such as --depth
+ * @param text The option's value
+ * @param value Set to the count, at least 1
+ * @return False if the value is not a number
+ */
+bool parseCountOption(const string& text, size_t& value) {
+    if (text.empty() || text.find_first_not_of("0123456789") != string::npos || text.size() > 9) {
+        return false;
+    }
+    value = max<size_t>(1, stoul(text));
+    return true;
+}
+
+// Entry point of the program
+int main(int argc, char* argv[]) {
+    BenchmarkOptions options;
+    bool benchmark = false;
+    string request;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--socket" && hasValue) {
+            options.socketPath = argv[++i];
+        } else if (arg == "--bench" && hasValue) {
+            benchmark = true;
+            options.keysFile = argv[++i];
+        } else if ((arg == "--connections" || arg == "--requests" || arg == "--depth") && hasValue) {
+            size_t& count = arg == "--connections" ? options.connections
+                          : arg == "--requests" ? options.requests : options.depth;
+            if (!parseCountOption(argv[++i], count)) {
+                cerr << "Error: " << arg << " must be a positive number." << endl;
+                return 1;
+            }
+        } else if (arg == "--background-list") {
+            options.backgroundList = true;
+        } else if (arg == "--help" || arg.rfind("--", 0) == 0) {
+            printUsage(argv[0]);
+            return arg == "--help" ? 0 : 1;
+        } else {
+            request += (request.empty() ? "" : " ") + arg;
+        }
+    }
+
+    if (benchmark) {
+        return runLoadGenerator(options);
+    }
+    return runClient(options.socketPath, request);
+}
@@ -0,0 +1,935 @@
+//============================================================================
+// Name        : CourseEngineBench.cpp
+// Author      : Erik Olsen
+// Version     : 1.0
+// Course      : CS-300
+// Description : Storage engine comparison for the course catalog. The
+//               catalog operations (load, search, list, add, remove,
+//               cleanup) are written once against a storage engine
+//               template parameter; each engine is compiled into its own
+//               benchmark binary, so no engine pays for virtual calls.
+//
+// Build one binary per engine:
+//   g++ -O2 -std=c++17 -o bench_chained CourseEngineBench.cpp
+//   g++ -O2 -std=c++17 -DCATALOG_ENGINE_FLAT -o bench_flat CourseEngineBench.cpp
+//   g++ -O2 -std=c++17 -DCATALOG_ENGINE_SORTED -o bench_sorted CourseEngineBench.cpp
+//   g++ -O2 -std=c++17 -DCATALOG_ENGINE_BTREE -o bench_btree CourseEngineBench.cpp
+//============================================================================
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <chrono>
+#include <random>
+#include <iomanip>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+
+using namespace std;
+using namespace std::chrono;
+
+//=============================================================================
+// Course Structure Definition
+//=============================================================================
+
+// Structure to represent a single course
+struct Course {
+    string courseNumber; // Unique course identifier (e.g., "CSCI300")
+    string courseTitle; // Course name
+    vector<string> prerequisites; // List of prerequisite course numbers
+};
+
+/**
+ * Trims leading and trailing whitespace from a string
+ * @param str The string to trim
+ * @return The trimmed string
+ */
+string trim(const string& str) {
+    size_t first = str.find_first_not_of(" \t\r\n");
+    if (first == string::npos) {
+        return "";
+    }
+    size_t last = str.find_last_not_of(" \t\r\n");
+    return str.substr(first, last - first + 1);
+}
+
+/**
+ * Converts a string to uppercase
+ * @param str The string to convert
+ * @return The uppercase version of the string
+ */
+string toUpperCase(string str) {
+    transform(str.begin(), str.end(), str.begin(), ::toupper);
+    return str;
+}
+
+/**
+ * Split a string by a delimiter, trimming each token
+ * @param str The string to split
+ * @param delimiter The delimiter character
+ * @return A vector of tokens
+ */
+vector<string> split(const string& str, char delimiter) {
+    vector<string> tokens;
+    stringstream ss(str);
+    string token;
+    while (getline(ss, token, delimiter)) {
+        tokens.push_back(trim(token));
+    }
+    return tokens;
+}
+
+//=============================================================================
+// Storage Engines
+//=============================================================================
+//
+// Every engine provides the same members, which Catalog<Engine> calls
+// directly:
+//   NAME, ORDERED                  Display name; whether forEach visits in
+//                                  course-number order
+//   reserve(n)                     Prepare for n courses
+//   insert(Course&&)               False if the course number is taken
+//   insertAll(vector<Course>&&)    Bulk insert of distinct new courses
+//   find(number) / findMutable(number)
+//   remove(number)                 False if not found
+//   forEach(visit) / forEachMutable(visit)
+//   size()
+//
+// Pointers returned by find() are valid until the next insert or remove.
+
+/**
+ * Separate chaining, as in the interactive programs: a bucket array of
+ * singly linked nodes, grown to keep the load factor at most 0.75
+ */
+class ChainedHashEngine {
+public:
+    static constexpr const char* NAME = "chained hash";
+    static constexpr bool ORDERED = false;
+
+    ChainedHashEngine() : buckets(179, nullptr) {}
+
+    ~ChainedHashEngine() {
+        for (Node* head : buckets) {
+            while (head != nullptr) {
+                Node* next = head->next;
+                delete head;
+                head = next;
+            }
+        }
+    }
+
+    ChainedHashEngine(const ChainedHashEngine&) = delete;
+    ChainedHashEngine& operator=(const ChainedHashEngine&) = delete;
+
+    void reserve(size_t courseCount) {
+        if (courseCount + courseCount / 3 > buckets.size()) {
+            rehash(courseCount + courseCount / 3);
+        }
+    }
+
+    bool insert(Course&& course) {
+        if (find(course.courseNumber) != nullptr) {
+            return false;
+        }
+        if ((count + 1) * 4 > buckets.size() * 3) {
+            rehash(buckets.size() * 2 + 1);
+        }
+        size_t index = hashKey(course.courseNumber) % buckets.size();
+        buckets[index] = new Node{std::move(course), buckets[index]};
+        ++count;
+        return true;
+    }
+
+    void insertAll(vector<Course>&& courses) {
+        reserve(count + courses.size());
+        for (auto& course : courses) {
+            insert(std::move(course));
+        }
+    }
+
+    const Course* find(const string& courseNumber) const {
+        for (const Node* node = buckets[hashKey(courseNumber) % buckets.size()]; node != nullptr; node = node->next) {
+            if (node->course.courseNumber == courseNumber) {
+                return &node->course;
+            }
+        }
+        return nullptr;
+    }
+
+    Course* findMutable(const string& courseNumber) {
+        return const_cast<Course*>(find(courseNumber));
+    }
+
+    bool remove(const string& courseNumber) {
+        for (Node** link = &buckets[hashKey(courseNumber) % buckets.size()]; *link != nullptr; link = &(*link)->next) {
+            if ((*link)->course.courseNumber == courseNumber) {
+                Node* node = *link;
+                *link = node->next;
+                delete node;
+                --count;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        for (const Node* head : buckets) {
+            for (const Node* node = head; node != nullptr; node = node->next) {
+                visit(node->course);
+            }
+        }
+    }
+
+    template <typename Visitor>
+    void forEachMutable(Visitor visit) {
+        for (Node* head : buckets) {
+            for (Node* node = head; node != nullptr; node = node->next) {
+                visit(node->course);
+            }
+        }
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+private:
+    struct Node {
+        Course course;
+        Node* next;
+    };
+
+    static size_t hashKey(const string& key) {
+        size_t hashValue = 0;
+        for (char ch : key) {
+            hashValue = hashValue * 31 + static_cast<unsigned char>(ch);
+        }
+        return hashValue;
+    }
+
+    void rehash(size_t bucketCount) {
+        vector<Node*> oldBuckets(bucketCount, nullptr);
+        oldBuckets.swap(buckets);
+        for (Node* head : oldBuckets) {
+            while (head != nullptr) {
+                Node* node = head;
+                head = head->next;
+                size_t index = hashKey(node->course.courseNumber) % buckets.size();
+                node->next = buckets[index];
+                buckets[index] = node;
+            }
+        }
+    }
+
+    vector<Node*> buckets;
+    size_t count = 0;
+};
+
+/**
+ * Open addressing with linear probing: courses live inline in one slot
+ * array, next to an array of their key hashes (0 marks an empty slot).
+ * Removal shifts later entries of the probe run back, so there are no
+ * tombstones. Kept at most 3/4 full.
+ */
+class FlatHashEngine {
+public:
+    static constexpr const char* NAME = "flat hash";
+    static constexpr bool ORDERED = false;
+
+    FlatHashEngine() {
+        resize(16);
+    }
+
+    void reserve(size_t courseCount) {
+        size_t capacity = slots.size();
+        while (courseCount * 4 > capacity * 3) {
+            capacity *= 2;
+        }
+        if (capacity != slots.size()) {
+            resize(capacity);
+        }
+    }
+
+    bool insert(Course&& course) {
+        reserve(count + 1);
+        uint64_t keyHash = hashKey(course.courseNumber);
+        size_t index = home(keyHash);
+        for (; hashes[index] != 0; index = (index + 1) & mask) {
+            if (hashes[index] == keyHash && slots[index].courseNumber == course.courseNumber) {
+                return false;
+            }
+        }
+        hashes[index] = keyHash;
+        slots[index] = std::move(course);
+        ++count;
+        return true;
+    }
+
+    void insertAll(vector<Course>&& courses) {
+        reserve(count + courses.size());
+        for (auto& course : courses) {
+            insert(std::move(course));
+        }
+    }
+
+    const Course* find(const string& courseNumber) const {
+        size_t index = locate(courseNumber);
+        return index == NOT_FOUND ? nullptr : &slots[index];
+    }
+
+    Course* findMutable(const string& courseNumber) {
+        size_t index = locate(courseNumber);
+        return index == NOT_FOUND ? nullptr : &slots[index];
+    }
+
+    bool remove(const string& courseNumber) {
+        size_t hole = locate(courseNumber);
+        if (hole == NOT_FOUND) {
+            return false;
+        }
+        // Pull back every later entry of the run that may sit in the hole
+        for (size_t next = (hole + 1) & mask; hashes[next] != 0; next = (next + 1) & mask) {
+            size_t wanted = home(hashes[next]);
+            if (((next - wanted) & mask) >= ((next - hole) & mask)) {
+                hashes[hole] = hashes[next];
+                slots[hole] = std::move(slots[next]);
+                hole = next;
+            }
+        }
+        hashes[hole] = 0;
+        slots[hole] = Course();
+        --count;
+        return true;
+    }
+
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        for (size_t i = 0; i < slots.size(); ++i) {
+            if (hashes[i] != 0) {
+                visit(slots[i]);
+            }
+        }
+    }
+
+    template <typename Visitor>
+    void forEachMutable(Visitor visit) {
+        for (size_t i = 0; i < slots.size(); ++i) {
+            if (hashes[i] != 0) {
+                visit(slots[i]);
+            }
+        }
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+private:
+    static const size_t NOT_FOUND = static_cast<size_t>(-1);
+
+    // 64-bit FNV-1a, never 0 so that 0 can mark empty slots
+    static uint64_t hashKey(const string& key) {
+        uint64_t hashValue = 14695981039346656037ull;
+        for (char ch : key) {
+            hashValue = (hashValue ^ static_cast<unsigned char>(ch)) * 1099511628211ull;
+        }
+        return hashValue | 1;
+    }
+
+    // Fibonacci hashing: the top bits of hash * 2^64/phi pick the home slot
+    size_t home(uint64_t keyHash) const {
+        return static_cast<size_t>((keyHash * 0x9E3779B97F4A7C15ull) >> shift);
+    }
+
+    size_t locate(const string& courseNumber) const {
+        uint64_t keyHash = hashKey(courseNumber);
+        for (size_t index = home(keyHash); hashes[index] != 0; index = (index + 1) & mask) {
+            if (hashes[index] == keyHash && slots[index].courseNumber == courseNumber) {
+                return index;
+            }
+        }
+        return NOT_FOUND;
+    }
+
+    void resize(size_t capacity) {
+        vector<Course> oldSlots(capacity);
+        vector<uint64_t> oldHashes(capacity, 0);
+        oldSlots.swap(slots);
+        oldHashes.swap(hashes);
+        mask = capacity - 1;
+        shift = 64;
+        for (size_t bits = capacity; bits > 1; bits /= 2) {
+            --shift;
+        }
+        for (size_t i = 0; i < oldSlots.size(); ++i) {
+            if (oldHashes[i] != 0) {
+                size_t index = home(oldHashes[i]);
+                while (hashes[index] != 0) {
+                    index = (index + 1) & mask;
+                }
+                hashes[index] = oldHashes[i];
+                slots[index] = std::move(oldSlots[i]);
+            }
+        }
+    }
+
+    vector<Course> slots;
+    vector<uint64_t> hashes;
+    size_t mask = 0;
+    unsigned int shift = 64;
+    size_t count = 0;
+};
+
+/**
+ * One vector of courses kept in course-number order: binary search for
+ * lookups, and already sorted for listings. Single inserts and removes
+ * shift the tail; bulk inserts sort the batch and merge it in.
+ */
+class SortedVectorEngine {
+public:
+    static constexpr const char* NAME = "sorted vector";
+    static constexpr bool ORDERED = true;
+
+    void reserve(size_t courseCount) {
+        courses.reserve(courseCount);
+    }
+
+    bool insert(Course&& course) {
+        auto position = lowerBound(course.courseNumber);
+        if (position != courses.end() && position->courseNumber == course.courseNumber) {
+            return false;
+        }
+        courses.insert(position, std::move(course));
+        return true;
+    }
+
+    void insertAll(vector<Course>&& batch) {
+        sort(batch.begin(), batch.end(), [](const Course& a, const Course& b) {
+            return a.courseNumber < b.courseNumber;
+        });
+        size_t middle = courses.size();
+        courses.insert(courses.end(), make_move_iterator(batch.begin()), make_move_iterator(batch.end()));
+        inplace_merge(courses.begin(), courses.begin() + middle, courses.end(), [](const Course& a, const Course& b) {
+            return a.courseNumber < b.courseNumber;
+        });
+    }
+
+    const Course* find(const string& courseNumber) const {
+        auto position = lowerBound(courseNumber);
+        return position != courses.end() && position->courseNumber == courseNumber ? &*position : nullptr;
+    }
+
+    Course* findMutable(const string& courseNumber) {
+        return const_cast<Course*>(find(courseNumber));
+    }
+
+    bool remove(const string& courseNumber) {
+        auto position = lowerBound(courseNumber);
+        if (position == courses.end() || position->courseNumber != courseNumber) {
+            return false;
+        }
+        courses.erase(position);
+        return true;
+    }
+
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        for (const auto& course : courses) {
+            visit(course);
+        }
+    }
+
+    template <typename Visitor>
+    void forEachMutable(Visitor visit) {
+        for (auto& course : courses) {
+            visit(course);
+        }
+    }
+
+    size_t size() const {
+        return courses.size();
+    }
+
+private:
+    vector<Course>::const_iterator lowerBound(const string& courseNumber) const {
+        return lower_bound(courses.begin(), courses.end(), courseNumber, [](const Course& course, const string& key) {
+            return course.courseNumber < key;
+        });
+    }
+
+    vector<Course> courses;
+};
+
+/**
+ * B+ tree: inner nodes hold separator keys, leaves hold up to
+ * LEAF_CAPACITY courses in order and are chained left to right for
+ * in-order scans. Removal does not rebalance; leaves may run underfull
+ * (or empty) until the tree is rebuilt, which keeps removal a leaf-local
+ * erase.
+ */
+class BTreeEngine {
+public:
+    static constexpr const char* NAME = "B+ tree";
+    static constexpr bool ORDERED = true;
+
+    BTreeEngine() : root(new Node(true)), firstLeaf(root.get()) {}
+
+    void reserve(size_t) {}
+
+    bool insert(Course&& course) {
+        if (find(course.courseNumber) != nullptr) {
+            return false;
+        }
+        string separator;
+        unique_ptr<Node> right = insertInto(root.get(), std::move(course), separator);
+        if (right) {
+            // The root split: grow the tree by one level
+            auto newRoot = make_unique<Node>(false);
+            newRoot->keys.push_back(std::move(separator));
+            newRoot->children.push_back(std::move(root));
+            newRoot->children.push_back(std::move(right));
+            root = std::move(newRoot);
+        }
+        ++count;
+        return true;
+    }
+
+    void insertAll(vector<Course>&& courses) {
+        for (auto& course : courses) {
+            insert(std::move(course));
+        }
+    }
+
+    const Course* find(const string& courseNumber) const {
+        const Node* leaf = leafFor(courseNumber);
+        auto position = lowerBound(leaf->courses, courseNumber);
+        return position != leaf->courses.end() && position->courseNumber == courseNumber ? &*position : nullptr;
+    }
+
+    Course* findMutable(const string& courseNumber) {
+        return const_cast<Course*>(find(courseNumber));
+    }
+
+    bool remove(const string& courseNumber) {
+        Node* leaf = const_cast<Node*>(leafFor(courseNumber));
+        auto position = lowerBound(leaf->courses, courseNumber);
+        if (position == leaf->courses.end() || position->courseNumber != courseNumber) {
+            return false;
+        }
+        leaf->courses.erase(position);
+        --count;
+        return true;
+    }
+
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        for (const Node* leaf = firstLeaf; leaf != nullptr; leaf = leaf->next) {
+            for (const auto& course : leaf->courses) {
+                visit(course);
+            }
+        }
+    }
+
+    template <typename Visitor>
+    void forEachMutable(Visitor visit) {
+        for (Node* leaf = firstLeaf; leaf != nullptr; leaf = leaf->next) {
+            for (auto& course : leaf->courses) {
+                visit(course);
+            }
+        }
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+private:
+    static const size_t LEAF_CAPACITY = 32;
+    static const size_t INNER_CAPACITY = 32;
+
+    struct Node {
+        explicit Node(bool isLeaf) : leaf(isLeaf) {}
+
+        bool leaf;
+        vector<string> keys;               // Inner: children[i] holds keys < keys[i]
+        vector<unique_ptr<Node>> children; // Inner
+        vector<Course> courses;            // Leaf, in course-number order
+        Node* next = nullptr;              // Leaf: the leaf to the right
+    };
+
+    static vector<Course>::const_iterator lowerBound(const vector<Course>& courses, const string& courseNumber) {
+        return lower_bound(courses.begin(), courses.end(), courseNumber, [](const Course& course, const string& key) {
+            return course.courseNumber < key;
+        });
+    }
+
+    const Node* leafFor(const string& courseNumber) const {
+        const Node* node = root.get();
+        while (!node->leaf) {
+            size_t child = upper_bound(node->keys.begin(), node->keys.end(), courseNumber) - node->keys.begin();
+            node = node->children[child].get();
+        }
+        return node;
+    }
+
+    /**
+     * Insert below a node, splitting it if it overflows
+     * @param node The subtree root
+     * @param course The course to insert (its number is not in the tree)
+     * @param separator Set to the first key of the new right node on a split
+     * @return The new right sibling if the node split, otherwise null
+     */
+    unique_ptr<Node> insertInto(Node* node, Course&& course, string& separator) {
+        if (node->leaf) {
+            auto position = lowerBound(node->courses, course.courseNumber);
+            node->courses.insert(position, std::move(course));
+            if (node->courses.size() <= LEAF_CAPACITY) {
+                return nullptr;
+            }
+            auto right = make_unique<Node>(true);
+            size_t half = node->courses.size() / 2;
+            right->courses.assign(make_move_iterator(node->courses.begin() + half), make_move_iterator(node->courses.end()));
+            node->courses.erase(node->courses.begin() + half, node->courses.end());
+            right->next = node->next;
+            node->next = right.get();
+            separator = right->courses.front().courseNumber;
+            return right;
+        }
+
+        size_t child = upper_bound(node->keys.begin(), node->keys.end(), course.courseNumber) - node->keys.begin();
+        string childSeparator;
+        unique_ptr<Node> childRight = insertInto(node->children[child].get(), std::move(course), childSeparator);
+        if (!childRight) {
+            return nullptr;
+        }
+        node->keys.insert(node->keys.begin() + child, std::move(childSeparator));
+        node->children.insert(node->children.begin() + child + 1, std::move(childRight));
+        if (node->children.size() <= INNER_CAPACITY) {
+            return nullptr;
+        }
+
+        // Split the inner node; the middle key moves up
+        auto right = make_unique<Node>(false);
+        size_t middle = node->keys.size() / 2;
+        separator = std::move(node->keys[middle]);
+        right->keys.assign(make_move_iterator(node->keys.begin() + middle + 1), make_move_iterator(node->keys.end()));
+        right->children.assign(make_move_iterator(node->children.begin() + middle + 1),
+                               make_move_iterator(node->children.end()));
+        node->keys.erase(node->keys.begin() + middle, node->keys.end());
+        node->children.erase(node->children.begin() + middle + 1, node->children.end());
+        return right;
+    }
+
+    unique_ptr<Node> root;
+    Node* firstLeaf;
+    size_t count = 0;
+};
+
+//=============================================================================
+// Catalog Operations
+//=============================================================================
+
+/**
+ * The catalog operations of the interactive programs, written once for
+ * any storage engine
+ */
+template <typename Engine>
+class Catalog {
+public:
+    /**
+     * Load a CSV catalog, validating it completely before inserting
+     * @param filename Path to the CSV file
+     * @param err Stream for error messages
+     * @return True if the file loaded
+     */
+    bool load(const string& filename, ostream& err) {
+        ifstream file(filename);
+        if (!file.is_open()) {
+            err << "Error: Could not open file " << filename << endl;
+            return false;
+        }
+
+        vector<Course> courses;
+        unordered_map<string, size_t> lineOf;
+        string line;
+        size_t lineNumber = 0;
+        while (getline(file, line)) {
+            ++lineNumber;
+            if (trim(line).empty()) {
+                continue;
+            }
+            vector<string> tokens = split(line, ',');
+            if (tokens.size() < 2 || tokens[0].empty() || tokens[1].empty()) {
+                err << "Error: Line " << lineNumber << " - Invalid format (missing course number or title)" << endl;
+                return false;
+            }
+            Course course;
+            course.courseNumber = toUpperCase(tokens[0]);
+            course.courseTitle = tokens[1];
+            for (size_t i = 2; i < tokens.size(); ++i) {
+                if (!tokens[i].empty()) {
+                    course.prerequisites.push_back(toUpperCase(tokens[i]));
+                }
+            }
+            if (!lineOf.emplace(course.courseNumber, lineNumber).second) {
+                err << "Error: Course '" << course.courseNumber << "' is defined twice." << endl;
+                return false;
+            }
+            courses.push_back(std::move(course));
+        }
+        for (const auto& course : courses) {
+            for (const auto& prereq : course.prerequisites) {
+                if (lineOf.count(prereq) == 0 && engine.find(prereq) == nullptr) {
+                    err << "Error: Prerequisite '" << prereq << "' for course '" << course.courseNumber
+                        << "' does not exist in the course list." << endl;
+                    return false;
+                }
+            }
+        }
+        engine.insertAll(std::move(courses));
+        return true;
+    }
+
+    /**
+     * Look up a course
+     * @param courseNumber The course number (case-insensitive)
+     * @return The course, or nullptr if not found
+     */
+    const Course* search(const string& courseNumber) const {
+        return engine.find(toUpperCase(trim(courseNumber)));
+    }
+
+    /**
+     * Print one course's details
+     * @param courseNumber The course number (case-insensitive)
+     * @param out Stream for the details
+     * @return True if the course was found
+     */
+    bool printCourse(const string& courseNumber, ostream& out) const {
+        const Course* course = search(courseNumber);
+        if (course == nullptr) {
+            out << "Error: Course '" << courseNumber << "' not found." << endl;
+            return false;
+        }
+        out << course->courseNumber << ", " << course->courseTitle << "\nPrerequisites: ";
+        for (size_t i = 0; i < course->prerequisites.size(); ++i) {
+            out << (i > 0 ? ", " : "") << course->prerequisites[i];
+        }
+        out << (course->prerequisites.empty() ? "None\n" : "\n");
+        return true;
+    }
+
+    /**
+     * Print every course in course-number order; ordered engines skip the sort
+     * @param out Stream for the listing
+     * @return Number of courses printed
+     */
+    size_t printList(ostream& out) const {
+        vector<const Course*> courses;
+        courses.reserve(engine.size());
+        engine.forEach([&courses](const Course& course) { courses.push_back(&course); });
+        if constexpr (!Engine::ORDERED) {
+            sort(courses.begin(), courses.end(), [](const Course* a, const Course* b) {
+                return a->courseNumber < b->courseNumber;
+            });
+        }
+        for (const Course* course : courses) {
+            out << course->courseNumber << ", " << course->courseTitle << '\n';
+        }
+        return courses.size();
+    }
+
+    /**
+     * Add a course whose prerequisites all exist
+     * @param course The course to add
+     * @param err Stream for error messages
+     * @return True if the course was added
+     */
+    bool addCourse(Course course, ostream& err) {
+        for (const auto& prereq : course.prerequisites) {
+            if (engine.find(prereq) == nullptr) {
+                err << "Error: Prerequisite '" << prereq << "' does not exist in the course list." << endl;
+                return false;
+            }
+        }
+        string courseNumber = course.courseNumber;
+        if (!engine.insert(std::move(course))) {
+            err << "Error: Course " << courseNumber << " already exists." << endl;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Find every course that lists a course as a prerequisite
+     * @param courseNumber The course number
+     * @return Course numbers of the dependent courses
+     */
+    vector<string> findDependents(const string& courseNumber) const {
+        vector<string> dependents;
+        engine.forEach([&](const Course& course) {
+            if (std::find(course.prerequisites.begin(), course.prerequisites.end(), courseNumber) != course.prerequisites.end()) {
+                dependents.push_back(course.courseNumber);
+            }
+        });
+        return dependents;
+    }
+
+    /**
+     * Remove a course, optionally stripping it from other courses' prerequisites
+     * @param courseNumber The course number
+     * @param cleanup True to strip the course from every prerequisite list
+     * @return True if the course was removed
+     */
+    bool removeCourse(const string& courseNumber, bool cleanup) {
+        if (!engine.remove(courseNumber)) {
+            return false;
+        }
+        if (cleanup) {
+            engine.forEachMutable([&courseNumber](Course& course) {
+                auto& prereqs = course.prerequisites;
+                prereqs.erase(std::remove(prereqs.begin(), prereqs.end(), courseNumber), prereqs.end());
+            });
+        }
+        return true;
+    }
+
+    size_t size() const {
+        return engine.size();
+    }
+
+private:
+    Engine engine;
+};
+
+//=============================================================================
+// Engine Selection
+//=============================================================================
+
+#if defined(CATALOG_ENGINE_FLAT)
+using CatalogEngine = FlatHashEngine;
+#elif defined(CATALOG_ENGINE_SORTED)
+using CatalogEngine = SortedVectorEngine;
+#elif defined(CATALOG_ENGINE_BTREE)
+using CatalogEngine = BTreeEngine;
+#else
+using CatalogEngine = ChainedHashEngine;
+#endif
+
+//=============================================================================
+// Benchmark
+//=============================================================================
+
+// Print usage for the benchmark
+void printUsage(const char* program) {
+    cout << "Usage: " << program << " <file.csv> [lookups]" << endl;
+    cout << "Times load, lookups, sorted listing, adds and removes with cleanup" << endl;
+    cout << "for the storage engine this binary was built with (" << CatalogEngine::NAME << ")." << endl;
+}
+
+/**
+ * Seconds elapsed since a start time
+ * @param start The start time
+ * @return Elapsed seconds
+ */
+double secondsSince(high_resolution_clock::time_point start) {
+    return duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / 1e9;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 3 || string(argv[1]) == "--help") {
+        printUsage(argv[0]);
+        return argc == 2 ? 0 : 1;
+    }
+    size_t lookupCount = argc == 3 ? max(1ul, stoul(argv[2])) : 1000000;
+
+    Catalog<CatalogEngine> catalog;
+    auto start = high_resolution_clock::now();
+    if (!catalog.load(argv[1], cerr)) {
+        return 1;
+    }
+    double loadSeconds = secondsSince(start);
+    if (catalog.size() == 0) {
+        cerr << "Error: The catalog is empty; there is nothing to look up." << endl;
+        return 1;
+    }
+
+    // Random existing course numbers, and the same numbers with a suffix as misses
+    vector<string> courseNumbers;
+    ostringstream listing;
+    start = high_resolution_clock::now();
+    catalog.printList(listing);
+    double listSeconds = secondsSince(start);
+    istringstream lines(listing.str());
+    for (string line; getline(lines, line);) {
+        courseNumbers.push_back(line.substr(0, line.find(',')));
+    }
+    mt19937 generator(300);
+    vector<string> hits(lookupCount);
+    vector<string> misses(lookupCount);
+    for (size_t i = 0; i < lookupCount; ++i) {
+        hits[i] = courseNumbers[generator() % courseNumbers.size()];
+        misses[i] = hits[i] + "X";
+    }
+    auto timeLookups = [&catalog](const vector<string>& keys, size_t& found) {
+        auto lookupStart = high_resolution_clock::now();
+        found = 0;
+        for (const auto& key : keys) {
+            found += catalog.search(key) != nullptr;
+        }
+        return secondsSince(lookupStart) * 1e9 / keys.size();
+    };
+    size_t found = 0;
+    double hitNanos = timeLookups(hits, found);
+    if (found != lookupCount) {
+        cerr << "Error: Only " << found << " of " << lookupCount << " lookups found their course." << endl;
+        return 1;
+    }
+    double missNanos = timeLookups(misses, found);
+
+    // Adds: new courses that each require two existing ones
+    const size_t addCount = 10000;
+    start = high_resolution_clock::now();
+    for (size_t i = 0; i < addCount; ++i) {
+        Course course;
+        course.courseNumber = "NEW" + to_string(i);
+        course.courseTitle = "Added Course " + to_string(i);
+        course.prerequisites = {courseNumbers[generator() % courseNumbers.size()],
+                                courseNumbers[generator() % courseNumbers.size()]};
+        if (!catalog.addCourse(std::move(course), cerr)) {
+            return 1;
+        }
+    }
+    double addMicros = secondsSince(start) * 1e6 / addCount;
+
+    // Removes: each checks dependents, removes, and strips the course everywhere
+    const size_t removeCount = min<size_t>(100, courseNumbers.size());
+    size_t dependents = 0;
+    start = high_resolution_clock::now();
+    for (size_t i = 0; i < removeCount; ++i) {
+        const string& courseNumber = courseNumbers[i * courseNumbers.size() / removeCount];
+        dependents += catalog.findDependents(courseNumber).size();
+        if (!catalog.removeCourse(courseNumber, true)) {
+            cerr << "Error: Could not remove " << courseNumber << endl;
+            return 1;
+        }
+    }
+    double removeMicros = secondsSince(start) * 1e6 / removeCount;
+
+    cout << "Engine: " << CatalogEngine::NAME << " (" << courseNumbers.size() << " courses)" << endl;
+    cout << fixed << setprecision(3);
+    cout << "Load:   " << loadSeconds << " seconds" << endl;
+    cout << "List:   " << listSeconds << " seconds (sorted listing)" << endl;
+    cout << setprecision(1);
+    cout << "Lookup: " << hitNanos << " ns/hit, " << missNanos << " ns/miss" << endl;
+    cout << "Add:    " << addMicros << " us/course (" << addCount << " courses)" << endl;
+    cout << "Remove: " << removeMicros << " us/course with dependents check and cleanup (" << removeCount
+         << " courses, " << dependents << " dependents)" << endl;
+    return 0;
+}
@@ -19,6 +19,12 @@
 #include <chrono>
 #include <iomanip>
 
+#ifdef EMBEDDED_CATALOG
+#include <array>
+#include <string_view>
+#include <cstdint>
+#endif
+
 using namespace std;
 using namespace std:: chrono;
 
@@ -175,6 +181,166 @@ public:
 
 };
 
+#ifdef EMBEDDED_CATALOG
+//=============================================================================
+// Embedded Catalog (kiosk build)
+//=============================================================================
+
+// Build with -DEMBEDDED_CATALOG to compile a fixed catalog into the program.
+// EmbeddedCatalog.h is written by "CourseManagement --embed <file.csv> EmbeddedCatalog.h"
+// (CourseManagement_v1.2.cpp); the hash index below is computed by the compiler,
+// so at startup there is nothing to parse or allocate.
+
+// One course in the embedded catalog; text lives in the program's read-only data
+struct EmbeddedCourse {
+    std::string_view courseNumber;
+    std::string_view courseTitle;
+    unsigned int firstPrerequisite; // Index of the first entry in EMBEDDED_PREREQUISITES
+    unsigned int prerequisiteCount;
+};
+
+#include "EmbeddedCatalog.h"
+
+/**
+ * 64-bit FNV-1a, usable at compile time; each key is hashed only once
+ * @param key The course number to hash
+ * @return The hash value
+ */
+constexpr uint64_t embeddedHash(std::string_view key) {
+    uint64_t hashValue = 14695981039346656037ull;
+    for (char ch : key) {
+        hashValue = (hashValue ^ static_cast<unsigned char>(ch)) * 1099511628211ull;
+    }
+    return hashValue;
+}
+
+/**
+ * Derive one of a family of hash values from a key's hash (splitmix64 finalizer)
+ * @param keyHash The key's embeddedHash
+ * @param seed Selects the family member
+ * @return The mixed value
+ */
+constexpr uint64_t embeddedMix(uint64_t keyHash, uint32_t seed) {
+    uint64_t value = keyHash + seed * 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+// Perfect hash (hash and displace): keys are split into small buckets, and
+// each bucket gets its own seed under which its keys land in free slots.
+// Plain arrays rather than std::array keep compile-time evaluation cheap
+// enough for catalogs of about 10,000 courses under default compiler limits.
+// A lookup hashes the key once, then reads one seed, one slot and compares
+// one string.
+template <size_t N>
+struct PerfectHashIndex {
+    static constexpr size_t BUCKETS = N / 4 + 1;
+    static constexpr size_t SLOTS = N + N / 4 + 1;  // Spare slots keep the seed search short
+    static constexpr uint32_t EMPTY = static_cast<uint32_t>(N);
+
+    uint32_t seeds[BUCKETS] = {};
+    uint32_t slots[SLOTS] = {};                     // Course index, or EMPTY
+
+    constexpr size_t bucketOf(uint64_t keyHash) const {
+        return (keyHash >> 32) % BUCKETS;
+    }
+
+    constexpr size_t slotOf(uint64_t keyHash, uint32_t seed) const {
+        return embeddedMix(keyHash, seed) % SLOTS;
+    }
+};
+
+/**
+ * Build the perfect hash index for the embedded courses at compile time
+ * Buckets are placed largest first, when free slots are most plentiful
+ * @param courses The embedded courses (course numbers must be unique)
+ * @return The finished index
+ */
+template <size_t N>
+constexpr PerfectHashIndex<N> buildPerfectHashIndex(const std::array<EmbeddedCourse, N>& courses) {
+    using Index = PerfectHashIndex<N>;
+    Index index{};
+    for (auto& slot : index.slots) {
+        slot = Index::EMPTY;
+    }
+
+    uint64_t keyHashes[N] = {};
+    for (size_t i = 0; i < N; ++i) {
+        keyHashes[i] = embeddedHash(courses[i].courseNumber);
+    }
+
+    // Group course indexes by bucket (counting sort)
+    uint32_t bucketStart[Index::BUCKETS + 1] = {};
+    for (size_t i = 0; i < N; ++i) {
+        ++bucketStart[index.bucketOf(keyHashes[i]) + 1];
+    }
+    size_t largestBucket = 0;
+    for (size_t b = 0; b < Index::BUCKETS; ++b) {
+        largestBucket = max<size_t>(largestBucket, bucketStart[b + 1]);
+        bucketStart[b + 1] += bucketStart[b];
+    }
+    uint32_t members[N] = {};
+    uint32_t nextMember[Index::BUCKETS + 1] = {};
+    for (size_t b = 0; b <= Index::BUCKETS; ++b) {
+        nextMember[b] = bucketStart[b];
+    }
+    for (size_t i = 0; i < N; ++i) {
+        members[nextMember[index.bucketOf(keyHashes[i])]++] = static_cast<uint32_t>(i);
+    }
+
+    for (size_t size = largestBucket; size > 0; --size) {
+        for (size_t b = 0; b < Index::BUCKETS; ++b) {
+            if (bucketStart[b + 1] - bucketStart[b] != size) {
+                continue;
+            }
+            for (uint32_t seed = 1;; ++seed) {
+                if (seed > 1000000) {
+                    throw "duplicate course numbers in the embedded catalog";
+                }
+                // Claim a slot for every member; give them all back on a collision
+                size_t placed = 0;
+                for (; placed < size; ++placed) {
+                    uint32_t course = members[bucketStart[b] + placed];
+                    size_t slot = index.slotOf(keyHashes[course], seed);
+                    if (index.slots[slot] != Index::EMPTY) {
+                        break;
+                    }
+                    index.slots[slot] = course;
+                }
+                if (placed == size) {
+                    index.seeds[b] = seed;
+                    break;
+                }
+                for (size_t undo = 0; undo < placed; ++undo) {
+                    uint32_t course = members[bucketStart[b] + undo];
+                    index.slots[index.slotOf(keyHashes[course], seed)] = Index::EMPTY;
+                }
+            }
+        }
+    }
+    return index;
+}
+
+// Computed by the compiler and stored in the program's read-only data
+constexpr auto EMBEDDED_INDEX = buildPerfectHashIndex(EMBEDDED_COURSES);
+
+/**
+ * Find a course in the embedded catalog with a single probe
+ * @param courseNumber The (uppercase) course number to search for
+ * @return Pointer to the course if found, nullptr otherwise
+ */
+const EmbeddedCourse* searchEmbeddedCourse(std::string_view courseNumber) {
+    uint64_t keyHash = embeddedHash(courseNumber);
+    uint32_t seed = EMBEDDED_INDEX.seeds[EMBEDDED_INDEX.bucketOf(keyHash)];
+    uint32_t candidate = EMBEDDED_INDEX.slots[EMBEDDED_INDEX.slotOf(keyHash, seed)];
+    if (candidate == EMBEDDED_INDEX.EMPTY || EMBEDDED_COURSES[candidate].courseNumber != courseNumber) {
+        return nullptr;
+    }
+    return &EMBEDDED_COURSES[candidate];
+}
+#endif
+
 //=============================================================================
 // Utility Functions
 //=============================================================================
@@ -432,6 +598,86 @@ void printCourseInformation(HashTable& hashTable, const string& courseNumber) {
     cout << "Time to print: " << fixed << setprecision(6) << seconds << " seconds" << endl;
 }
 
+#ifdef EMBEDDED_CATALOG
+/**
+ * Print all embedded courses; the generator already sorted them
+ */
+void printEmbeddedCourseList() {
+    // Start timing
+    auto startTime = high_resolution_clock::now();
+    clock_t startTicks = clock();
+
+    // Print header
+    cout << "Here is a sample schedule:" << endl;
+    cout << endl;
+
+    // Print each course
+    for (const auto& course : EMBEDDED_COURSES) {
+        cout << course.courseNumber << ", " << course.courseTitle << endl;
+    }
+
+    // End timing
+    auto endTime = high_resolution_clock::now();
+    clock_t endTicks = clock();
+
+    // Calculate elapsed time
+    auto duration = duration_cast<microseconds>(endTime - startTime);
+    double seconds = duration.count() / 1000000.0;
+    clock_t ticks = endTicks - startTicks;
+
+    cout << "Time to print: " << ticks << " clock ticks" << endl;
+    cout << "Time to print: " << fixed << setprecision(6) << seconds << " seconds" << endl;
+    cout << endl;
+}
+
+/**
+ * Search for and print a specific embedded course's information
+ * @param courseNumber The course number to search for
+ */
+void printEmbeddedCourseInformation(const string& courseNumber) {
+    // Start timing
+    auto startTime = high_resolution_clock::now();
+    clock_t startTicks = clock();
+
+    // Convert to uppercase for case-insensitive search
+    const EmbeddedCourse* course = searchEmbeddedCourse(toUpperCase(courseNumber));
+
+    if (course == nullptr) {
+        cout << "Course " << courseNumber << " not found. Please check the course number and try again." << endl;
+        return;
+    }
+
+    // Print course information
+    cout << course->courseNumber << ", " << course->courseTitle << endl;
+
+    // Print prerequisites if they exist
+    if (course->prerequisiteCount == 0) {
+        cout << "Prerequisites: None" << endl;
+    } else {
+        cout << "Prerequisites: ";
+        for (unsigned int i = 0; i < course->prerequisiteCount; ++i) {
+            cout << EMBEDDED_PREREQUISITES[course->firstPrerequisite + i];
+            if (i < course->prerequisiteCount - 1) {
+                cout << ", ";
+            }
+        }
+        cout << endl;
+    }
+
+    // End timing
+    auto endTime = high_resolution_clock::now();
+    clock_t endTicks = clock();
+
+    // Calculate elapsed time
+    auto duration = duration_cast<microseconds>(endTime - startTime);
+    double seconds = duration.count() / 1000000.0;
+    clock_t ticks = endTicks - startTicks;
+
+    cout << "Time to print: " << ticks << " clock ticks" << endl;
+    cout << "Time to print: " << fixed << setprecision(6) << seconds << " seconds" << endl;
+}
+#endif
+
 // Display the main menu and get user choice
 void displayMenu() {
     cout << "1. Load Data File." << endl;
@@ -452,7 +698,11 @@ int main() {
     HashTable courseHashTable;
 
     // Flag to track if data is loaded
+#ifdef EMBEDDED_CATALOG
+    bool dataLoaded = true;
+#else
     bool dataLoaded = false;
+#endif
 
     int choice =0;
     string filename;
@@ -474,6 +724,11 @@ int main() {
         // Process menu choice
         switch (choice) {
             case 1:
+#ifdef EMBEDDED_CATALOG
+                // The catalog is compiled in
+                cout << "The catalog (" << EMBEDDED_COURSES.size() << " courses) is built into this program." << endl;
+                cout << endl;
+#else
                 // Load data structure from CSV file
                 {
                     std::vector<std::string> csvFiles = getCsvFilesInCurrentDir();
@@ -500,6 +755,7 @@ int main() {
                     dataLoaded = true;
                 }
                 cout << endl;
+#endif
                 break;
 
             case 2:
@@ -507,7 +763,11 @@ int main() {
                 if (!dataLoaded) {
                     cout << "Please load data first (Option 1)." << endl;
                 } else {
+#ifdef EMBEDDED_CATALOG
+                    printEmbeddedCourseList();
+#else
                     printCourseList(courseHashTable);
+#endif
                 }
                 break;
 
@@ -518,7 +778,11 @@ int main() {
                 } else {
                     cout << "What course do you want to know about? ";
                     getline(cin, courseNumber);
+#ifdef EMBEDDED_CATALOG
+                    printEmbeddedCourseInformation(courseNumber);
+#else
                     printCourseInformation(courseHashTable, courseNumber);
+#endif
                     cout << endl;
                 }
                 break;
@@ -13,19 +13,81 @@
 #include <vector>
 #include <algorithm>
 #include <string>
+#include <string_view>
 #include <limits>
 #include <limits>
 #include <chrono>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <list>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <cassert>
+#include <cmath>
+#include <iterator>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <map>
+#include <deque>
+#include <memory>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <cerrno>
+#endif
+
+#if defined(__linux__) && defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define COURSE_SERVER_AVAILABLE 1
+#include <coroutine>
+#include <functional>
+#include <utility>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <fcntl.h>
+#include <csignal>
+#include <cerrno>
+#endif
+
+// Optional compressed catalog input: build with -DCOURSE_WITH_ZLIB (link -lz)
+// and/or -DCOURSE_WITH_ZSTD (link -lzstd)
+#ifdef COURSE_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef COURSE_WITH_ZSTD
+#include <zstd.h>
+#endif
 
 #include <filesystem>
-// Utility function to list CSV files in the current directory
+// Utility function to list CSV files in the current directory, including
+// compressed ones this build can read
 std::vector<std::string> getCsvFilesInCurrentDir() {
+    static const std::vector<std::string> extensions = {
+        ".csv",
+#ifdef COURSE_WITH_ZLIB
+        ".csv.gz",
+#endif
+#ifdef COURSE_WITH_ZSTD
+        ".csv.zst",
+#endif
+    };
     std::vector<std::string> csvFiles;
     for (const auto& entry : std::filesystem::directory_iterator(".")) {
         if (entry.is_regular_file()) {
             std::string name = entry.path().filename().string();
-            if (name.size() >= 4 && name.substr(name.size() - 4) == ".csv") {
-                csvFiles.push_back(name);
+            for (const auto& extension : extensions) {
+                if (name.size() >= extension.size() && name.compare(name.size() - extension.size(), extension.size(), extension) == 0) {
+                    csvFiles.push_back(name);
+                    break;
+                }
             }
         }
     }
@@ -37,6 +99,42 @@ std::vector<std::string> getCsvFilesInCurrentDir() {
 using namespace std;
 using namespace std:: chrono;
 
+// Build with -DCOURSE_COUNT_ALLOCATIONS to have --bench insert report how
+// many heap allocations each load path makes per course
+#ifdef COURSE_COUNT_ALLOCATIONS
+#include <cstdlib>
+#include <new>
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+// GCC does not see that free() below pairs with the malloc() in our operator new
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+atomic<size_t> heapAllocationCount{0};
+
+void* operator new(size_t size) {
+    heapAllocationCount.fetch_add(1, memory_order_relaxed);
+    if (void* block = malloc(size == 0 ? 1 : size)) {
+        return block;
+    }
+    throw bad_alloc();
+}
+
+void operator delete(void* block) noexcept {
+    free(block);
+}
+
+void operator delete(void* block, size_t) noexcept {
+    free(block);
+}
+
+size_t heapAllocations() {
+    return heapAllocationCount.load(memory_order_relaxed);
+}
+#else
+size_t heapAllocations() {
+    return 0;
+}
+#endif
+
 
 //=============================================================================
 //Course Structure Definition
@@ -48,370 +146,7458 @@ struct Course {
     string courseNumber; // Unique course identifier (e.g., "CSCI300")
     string courseTitle; // Course name
     vector<string> prerequisites; // List of prerequisite course numbers
+    string_view titleSource; // The title's bytes in a mapped catalog file or shared
+                             // catalog segment, used instead of courseTitle while set
 
     // Default constructor
     Course() {
         courseNumber = "";
         courseTitle = "";
     }
+
+    // Construct from parts, taking ownership of the strings passed in
+    Course(string number, string title, vector<string> prereqs = {})
+        : courseNumber(std::move(number)), courseTitle(std::move(title)), prerequisites(std::move(prereqs)) {}
+
+    // The course title, wherever it is stored
+    string_view title() const {
+        return titleSource.data() != nullptr ? titleSource : string_view(courseTitle);
+    }
+
+    // Replace the title with an owned string
+    void setTitle(string title) {
+        courseTitle = std::move(title);
+        titleSource = string_view();
+    }
+
+    // Copy a mapped title into courseTitle, for copies that may outlive the mapping
+    void materializeTitle() {
+        if (titleSource.data() != nullptr) {
+            setTitle(string(titleSource));
+        }
+    }
 };
+
 //=============================================================================
-// Hash Table Class Definition
+// Key Hashing for the Lookup Structures
 //=============================================================================
 
-// Hash table implementation for storing courses
-// Uses chaining for collision resolution
+// 64-bit FNV-1a of a course number; the frozen index and the lookup filter
+// derive everything else from it, so each key is hashed only once
+inline uint64_t courseKeyHash(string_view key) {
+    uint64_t hashValue = 14695981039346656037ull;
+    for (char ch : key) {
+        hashValue = (hashValue ^ static_cast<unsigned char>(ch)) * 1099511628211ull;
+    }
+    return hashValue;
+}
+
+// splitmix64 finalizer: one of a family of well-mixed values per seed
+inline uint64_t mixCourseKeyHash(uint64_t keyHash, uint32_t seed) {
+    uint64_t value = keyHash + seed * 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+// Map the high half of a hash onto [0, range) with a multiply instead of a division
+inline uint32_t reduceHash(uint64_t value, uint32_t range) {
+    return static_cast<uint32_t>(((value >> 32) * range) >> 32);
+}
+
+//=============================================================================
+// Course Number Sorting
+//=============================================================================
+
+// Ranges smaller than this are finished with a comparison sort
+const size_t RADIX_SORT_CUTOFF = 48;
+
+// Inputs at least this large are split across threads
+const size_t PARALLEL_SORT_MIN = 1 << 15;
+
+/**
+ * Sort one range by key, starting at a byte depth every key in the range
+ * has already matched on (MSD radix sort, one counting pass per byte)
+ * @param items The range to sort
+ * @param buffer Scratch space the size of the range
+ * @param digits Scratch space the size of the range
+ * @param count Number of items
+ * @param depth Number of leading key bytes known to be equal
+ * @param keyOf Returns an item's key as a string_view
+ */
+template <typename T, typename KeyOf>
+void radixSortByKey(T* items, T* buffer, uint16_t* digits, size_t count, size_t depth, const KeyOf& keyOf) {
+    if (count < RADIX_SORT_CUTOFF) {
+        sort(items, items + count, [&keyOf, depth](const T& a, const T& b) {
+            return keyOf(a).substr(depth) < keyOf(b).substr(depth);
+        });
+        return;
+    }
+
+    // Digit 0 is "key ends here", which sorts before every byte
+    size_t bucketEnd[257] = {};
+    for (size_t i = 0; i < count; ++i) {
+        string_view key = keyOf(items[i]);
+        digits[i] = key.size() > depth ? static_cast<uint16_t>(static_cast<unsigned char>(key[depth]) + 1) : 0;
+        ++bucketEnd[digits[i]];
+    }
+    size_t next[257];
+    size_t total = 0;
+    for (int b = 0; b < 257; ++b) {
+        next[b] = total;
+        total += bucketEnd[b];
+        bucketEnd[b] = total;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        buffer[next[digits[i]]++] = std::move(items[i]);
+    }
+    std::move(buffer, buffer + count, items);
+
+    for (int b = 1; b < 257; ++b) {
+        size_t start = bucketEnd[b - 1];
+        if (bucketEnd[b] - start > 1) {
+            radixSortByKey(items + start, buffer + start, digits + start, bucketEnd[b] - start, depth + 1, keyOf);
+        }
+    }
+}
+
+/**
+ * Sort items by a string key in the same order as comparing the keys with
+ * operator<, tuned for short ASCII course numbers. Large inputs are split
+ * into key ranges around sampled splitters (so shared prefixes such as
+ * "CSCI" do not leave one thread with most of the work) and each range is
+ * radix sorted on its own thread.
+ * @param items The items to sort (keys must stay put while sorting)
+ * @param keyOf Returns an item's key as a string_view
+ * @param threadCount Number of threads to sort on
+ */
+template <typename T, typename KeyOf>
+void sortByCourseNumber(vector<T>& items, const KeyOf& keyOf, unsigned int threadCount = 1) {
+    const size_t count = items.size();
+    vector<T> buffer(count);
+    vector<uint16_t> digits(count);
+    if (threadCount < 2 || count < PARALLEL_SORT_MIN) {
+        radixSortByKey(items.data(), buffer.data(), digits.data(), count, 0, keyOf);
+        return;
+    }
+
+    // Splitters from an evenly spaced sample, one range per thread
+    const size_t rangeCount = min(threadCount, 256u);
+    vector<string_view> sample;
+    for (size_t i = 0; i < count; i += max<size_t>(1, count / (rangeCount * 32))) {
+        sample.push_back(keyOf(items[i]));
+    }
+    sort(sample.begin(), sample.end());
+    vector<string_view> splitters;
+    for (size_t r = 1; r < rangeCount; ++r) {
+        splitters.push_back(sample[r * sample.size() / rangeCount]);
+    }
+
+    // Scatter each item into its range (digits holds the range number)
+    vector<size_t> rangeStart(rangeCount + 1, 0);
+    for (size_t i = 0; i < count; ++i) {
+        digits[i] = static_cast<uint16_t>(upper_bound(splitters.begin(), splitters.end(), keyOf(items[i])) - splitters.begin());
+        ++rangeStart[digits[i] + 1];
+    }
+    for (size_t r = 0; r < rangeCount; ++r) {
+        rangeStart[r + 1] += rangeStart[r];
+    }
+    vector<size_t> next(rangeStart.begin(), rangeStart.end() - 1);
+    for (size_t i = 0; i < count; ++i) {
+        buffer[next[digits[i]]++] = std::move(items[i]);
+    }
+    items.swap(buffer);
+
+    vector<thread> workers;
+    for (size_t r = 0; r < rangeCount; ++r) {
+        workers.emplace_back([&, r]() {
+            size_t start = rangeStart[r];
+            radixSortByKey(items.data() + start, buffer.data() + start, digits.data() + start,
+                           rangeStart[r + 1] - start, 0, keyOf);
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+}
+
+//=============================================================================
+// Frozen Course Index
+//=============================================================================
+
+/**
+ * Read-only minimal perfect hash index over a snapshot of the catalog
+ *
+ * Courses are copied into one dense array with exactly one slot per
+ * course. Keys are split into partitions of a few thousand; each
+ * partition is an independent hash-and-displace table (every small bucket
+ * of keys gets a seed under which its keys land in free slots), so
+ * partitions are built in parallel. A lookup hashes the key once, reads a
+ * partition descriptor and a seed, and compares the one candidate slot.
+ */
+class FrozenCourseIndex {
+public:
+    /**
+     * Build the index over a set of courses (course numbers must be unique)
+     * @param source The courses to copy into the index
+     * @param threadCount Number of threads to build partitions on
+     * @return False if no perfect hash was found (duplicate course numbers)
+     */
+    bool build(const vector<const Course*>& source, unsigned int threadCount) {
+        clear();
+        const size_t courseCount = source.size();
+        const uint32_t partitionCount = static_cast<uint32_t>(max<size_t>(1, courseCount / PARTITION_SIZE));
+
+        // Hash every key once and group the keys by partition (counting sort)
+        vector<uint64_t> keyHashes(courseCount);
+        vector<uint32_t> partitionStart(partitionCount + 1, 0);
+        for (size_t i = 0; i < courseCount; ++i) {
+            keyHashes[i] = courseKeyHash(source[i]->courseNumber);
+            ++partitionStart[partitionOf(keyHashes[i], partitionCount) + 1];
+        }
+        for (uint32_t p = 0; p < partitionCount; ++p) {
+            partitionStart[p + 1] += partitionStart[p];
+        }
+        vector<uint32_t> members(courseCount);
+        vector<uint32_t> nextMember(partitionStart.begin(), partitionStart.end() - 1);
+        for (size_t i = 0; i < courseCount; ++i) {
+            members[nextMember[partitionOf(keyHashes[i], partitionCount)]++] = static_cast<uint32_t>(i);
+        }
+
+        // A partition's slots are the range its keys occupy in members
+        partitions.resize(partitionCount);
+        uint32_t bucketTotal = 0;
+        for (uint32_t p = 0; p < partitionCount; ++p) {
+            uint32_t keyCount = partitionStart[p + 1] - partitionStart[p];
+            partitions[p] = {partitionStart[p], keyCount, bucketTotal, keyCount / 3 + 1};
+            bucketTotal += partitions[p].bucketCount;
+        }
+        seeds.assign(bucketTotal, 0);
+
+        vector<uint32_t> slotOwner(courseCount);
+        atomic<uint32_t> nextPartition{0};
+        atomic<bool> failed{false};
+        auto worker = [&]() {
+            for (uint32_t p = nextPartition++; p < partitionCount && !failed; p = nextPartition++) {
+                if (!buildPartition(partitions[p], members.data() + partitionStart[p], keyHashes, slotOwner)) {
+                    failed = true;
+                }
+            }
+        };
+        vector<thread> workers;
+        threadCount = max(1u, min(threadCount, partitionCount));
+        for (unsigned int t = 1; t < threadCount; ++t) {
+            workers.emplace_back(worker);
+        }
+        worker();
+        for (auto& w : workers) {
+            w.join();
+        }
+        if (failed) {
+            clear();
+            return false;
+        }
+
+        courses.reserve(courseCount);
+        for (uint32_t owner : slotOwner) {
+            courses.push_back(*source[owner]);
+        }
+        return true;
+    }
+
+    /**
+     * Look up a course with a single probe into the dense array
+     * @param courseNumber The course number to search for
+     * @param keyHash courseKeyHash(courseNumber)
+     * @return Pointer to the course if found, nullptr otherwise
+     */
+    const Course* find(const string& courseNumber, uint64_t keyHash) const {
+        uint64_t placement = mix(keyHash, 0);
+        const Partition& partition = partitions[reduce(placement, static_cast<uint32_t>(partitions.size()))];
+        if (partition.slotCount == 0) {
+            return nullptr;
+        }
+        uint32_t seed = seeds[partition.firstBucket + reduce(placement << 32, partition.bucketCount)];
+        const Course& candidate = courses[partition.firstSlot + reduce(mix(keyHash, seed), partition.slotCount)];
+        return candidate.courseNumber == courseNumber ? &candidate : nullptr;
+    }
+
+    bool empty() const {
+        return courses.empty();
+    }
+
+    size_t size() const {
+        return courses.size();
+    }
+
+    size_t partitionCount() const {
+        return partitions.size();
+    }
+
+    void clear() {
+        partitions.clear();
+        seeds.clear();
+        courses.clear();
+        courses.shrink_to_fit();
+    }
 
-class HashTable {
 private:
-    // Structure for nodes in the chain
-    struct Node {
-        Course course;
-        Node* next;
+    static const size_t PARTITION_SIZE = 2048;
+    static const uint32_t MAX_SEED = 1u << 24;
 
-        Node(Course aCourse) : course(aCourse), next(nullptr) {}
+    struct Partition {
+        uint32_t firstSlot;
+        uint32_t slotCount;
+        uint32_t firstBucket;
+        uint32_t bucketCount;
     };
 
-    vector<Node*> table; // Hash table buckets
-    unsigned int tableSize; // Size of the hash table
+    static uint64_t mix(uint64_t keyHash, uint32_t seed) {
+        return mixCourseKeyHash(keyHash, seed);
+    }
+
+    static uint32_t reduce(uint64_t value, uint32_t range) {
+        return reduceHash(value, range);
+    }
 
+    // The high half of mix(keyHash, 0) picks the partition, the low half the bucket
+    static uint32_t partitionOf(uint64_t keyHash, uint32_t partitionCount) {
+        return reduce(mix(keyHash, 0), partitionCount);
+    }
+
+    static uint32_t bucketOf(uint64_t keyHash, uint32_t bucketCount) {
+        return reduce(mix(keyHash, 0) << 32, bucketCount);
+    }
 
     /**
-     * This hash function determines the bucket index
-     * @param key The course number to hash
-     * @return The bucket index
+     * Assign seeds for one partition, placing its largest buckets first
+     * @param partition The partition's slot and bucket ranges
+     * @param keys Indexes (into keyHashes) of the partition's keys
+     * @param keyHashes Hash of every key
+     * @param slotOwner Receives the key index for each of the partition's slots
+     * @return False if some bucket could not be placed
      */
-    unsigned int hash(const string& key) {
-        unsigned int hashValue = 0;
-        for (char ch : key) {
-            hashValue = hashValue * 31 + ch;
+    bool buildPartition(const Partition& partition, const uint32_t* keys, const vector<uint64_t>& keyHashes,
+                        vector<uint32_t>& slotOwner) {
+        const uint32_t empty = numeric_limits<uint32_t>::max();
+        vector<uint32_t> bucketStart(partition.bucketCount + 1, 0);
+        for (uint32_t k = 0; k < partition.slotCount; ++k) {
+            ++bucketStart[bucketOf(keyHashes[keys[k]], partition.bucketCount) + 1];
+        }
+        uint32_t largestBucket = 0;
+        for (uint32_t b = 0; b < partition.bucketCount; ++b) {
+            largestBucket = max(largestBucket, bucketStart[b + 1]);
+            bucketStart[b + 1] += bucketStart[b];
+        }
+        vector<uint32_t> bucketKeys(partition.slotCount);
+        vector<uint32_t> nextKey(bucketStart.begin(), bucketStart.end() - 1);
+        for (uint32_t k = 0; k < partition.slotCount; ++k) {
+            bucketKeys[nextKey[bucketOf(keyHashes[keys[k]], partition.bucketCount)]++] = keys[k];
         }
-        return hashValue % tableSize;
+
+        vector<uint32_t> slots(partition.slotCount, empty);
+        for (uint32_t size = largestBucket; size > 0; --size) {
+            for (uint32_t b = 0; b < partition.bucketCount; ++b) {
+                if (bucketStart[b + 1] - bucketStart[b] != size) {
+                    continue;
+                }
+                const uint32_t* bucket = bucketKeys.data() + bucketStart[b];
+                uint32_t seed = 1;
+                for (;; ++seed) {
+                    if (seed > MAX_SEED) {
+                        return false;
+                    }
+                    // Claim a slot for every key; give them all back on a collision
+                    uint32_t placed = 0;
+                    for (; placed < size; ++placed) {
+                        uint32_t& slot = slots[reduce(mix(keyHashes[bucket[placed]], seed), partition.slotCount)];
+                        if (slot != empty) {
+                            break;
+                        }
+                        slot = bucket[placed];
+                    }
+                    if (placed == size) {
+                        break;
+                    }
+                    for (uint32_t undo = 0; undo < placed; ++undo) {
+                        slots[reduce(mix(keyHashes[bucket[undo]], seed), partition.slotCount)] = empty;
+                    }
+                }
+                seeds[partition.firstBucket + b] = seed;
+            }
+        }
+
+        copy(slots.begin(), slots.end(), slotOwner.begin() + partition.firstSlot);
+        return true;
     }
 
+    vector<Partition> partitions;
+    vector<uint32_t> seeds;   // One per bucket, all partitions back to back
+    vector<Course> courses;   // Dense, in slot order
+};
+
+//=============================================================================
+// Lookup Filter
+//=============================================================================
+
+/**
+ * Split-block Bloom filter over course numbers
+ *
+ * Each key maps to one 64-byte block (a single cache line) and sets one
+ * bit in each of the block's eight words, so a query touches one line and
+ * never needs a second hash. A "no" is definite; a "maybe" is wrong about
+ * 0.5% of the time at the default 12 bits per key. Keys cannot be taken
+ * out, so after removals the filter is rebuilt from the live courses.
+ */
+class CourseBloomFilter {
 public:
     /**
-     * Constructor to initialize the hash table with a specified size
-     * @param size The size of the hash table (default 179 - prime number)
+     * Clear the filter and size it for a number of keys
+     * @param expectedKeys Number of keys the filter should hold at full accuracy
      */
-    HashTable(unsigned int size = 179) {
-        tableSize = size;
-        table.resize(tableSize, nullptr);
+    void rebuild(size_t expectedKeys) {
+        keyCapacity = expectedKeys;
+        blocks.assign(max<size_t>(1, expectedKeys * BITS_PER_KEY / BLOCK_BITS), Block{});
     }
 
     /**
-     * Destructor to clean up memory used by the hash table
+     * Add a key
+     * @param keyHash courseKeyHash() of the course number
      */
-    ~HashTable() {
-        for (unsigned int i=0; i < tableSize; ++i) {
-            Node* current = table[i];
-            while (current != nullptr) {
-                Node* temp = current;
-                current = current->next;
-                delete temp;
-            }
+    void add(uint64_t keyHash) {
+        uint64_t value = mixCourseKeyHash(keyHash, FILTER_SEED);
+        Block& block = blocks[reduceHash(value, static_cast<uint32_t>(blocks.size()))];
+        for (int i = 0; i < 8; ++i) {
+            block.words[i] |= bitFor(value, i);
         }
     }
 
     /**
-     * Inserts a course into the hash table
-     * @param course The course to insert
+     * Check whether a key may be present; an unsized filter answers yes
+     * @param keyHash courseKeyHash() of the course number
+     * @return False only if the key was never added
      */
-    void insert(Course course) {
-        unsigned int index = hash(course.courseNumber);
+    bool mayContain(uint64_t keyHash) const {
+        if (keyCapacity == 0) {
+            return true;
+        }
+        uint64_t value = mixCourseKeyHash(keyHash, FILTER_SEED);
+        const Block& block = blocks[reduceHash(value, static_cast<uint32_t>(blocks.size()))];
+        // Branch-free over all eight words, which the compiler can vectorize
+        uint64_t missing = 0;
+        for (int i = 0; i < 8; ++i) {
+            missing |= ~block.words[i] & bitFor(value, i);
+        }
+        return missing == 0;
+    }
 
-        // Create a new node
-        Node* newNode = new Node(course);
+    size_t capacity() const {
+        return keyCapacity;
+    }
 
-        // If bucket is empty, insert at head
-        if (table[index] == nullptr) {
-            table[index] = newNode;
-        } else {
-            // Chain at the beginning for efficiency
-            newNode->next = table[index];
-            table[index] = newNode;
+    size_t bytes() const {
+        return blocks.size() * sizeof(Block);
+    }
+
+    void swap(CourseBloomFilter& other) {
+        blocks.swap(other.blocks);
+        std::swap(keyCapacity, other.keyCapacity);
+    }
+
+private:
+    static const size_t BITS_PER_KEY = 12;
+    static const size_t BLOCK_BITS = 512;
+    static const uint32_t FILTER_SEED = 1;   // Seed 0 belongs to the frozen index
+
+    struct alignas(64) Block {
+        uint64_t words[8] = {};
+    };
+
+    // Word i gets the bit picked by the top six bits of (low half * salt i)
+    static uint64_t bitFor(uint64_t value, int word) {
+        static const uint32_t SALT[8] = {0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du,
+                                         0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u};
+        return 1ull << ((static_cast<uint32_t>(value) * SALT[word]) >> 26);
+    }
+
+    vector<Block> blocks;
+    size_t keyCapacity = 0;
+};
+
+// How the lookup filter has been doing since the counters were last reset
+struct LookupFilterStats {
+    size_t rejected = 0;        // Misses answered by the filter alone
+    size_t passedFound = 0;     // Passed the filter and the course was there
+    size_t falsePositives = 0;  // Passed the filter but the course was not there
+};
+
+//=============================================================================
+// Course Detail Cache
+//=============================================================================
+
+/**
+ * Bounded LRU cache of rendered course detail blocks (the title line and
+ * the prerequisite line), keyed by course number
+ *
+ * The hash table owns one and drops a course's entry whenever that course
+ * is inserted, removed or handed out for modification, so a cached block
+ * is always what rendering the stored course would produce.
+ */
+class CourseDetailCache {
+public:
+    explicit CourseDetailCache(size_t capacity = 256) : maxEntries(capacity) {}
+
+    /**
+     * Look up a rendered block and mark it most recently used
+     * @param courseNumber The normalized course number
+     * @return Pointer to the block, or nullptr if it is not cached
+     */
+    const string* get(const string& courseNumber) {
+        auto found = index.find(courseNumber);
+        if (found == index.end()) {
+            ++missCount;
+            return nullptr;
         }
+        ++hitCount;
+        entries.splice(entries.begin(), entries, found->second);
+        return &found->second->second;
     }
 
     /**
-     * Search for a course by its course number
-     * @param courseNumber The course number to search for
-     * @return Pointer to the course if found, nullptr otherwise
+     * Store a rendered block, evicting the least recently used one when full
+     * @param courseNumber The normalized course number
+     * @param block The rendered detail text
+     * @return Reference to the stored block
      */
-    Course* search(const string& courseNumber) {
-        unsigned int index = hash(courseNumber);
-        Node* current = table[index];
+    const string& put(const string& courseNumber, string block) {
+        invalidate(courseNumber);
+        if (entries.size() >= maxEntries && !entries.empty()) {
+            index.erase(entries.back().first);
+            entries.pop_back();
+        }
+        entries.emplace_front(courseNumber, std::move(block));
+        index[courseNumber] = entries.begin();
+        return entries.front().second;
+    }
 
-        // Traverse the chain at this bucket
-        while (current != nullptr) {
-            if (current->course.courseNumber == courseNumber) {
-                return &(current->course);
-            }
-            current = current->next;
+    // Drop one course's block after the course changed
+    void invalidate(const string& courseNumber) {
+        auto found = index.find(courseNumber);
+        if (found != index.end()) {
+            entries.erase(found->second);
+            index.erase(found);
         }
+    }
 
-        return nullptr; // Course not found
+    void clear() {
+        entries.clear();
+        index.clear();
     }
 
+    size_t size() const {
+        return entries.size();
+    }
 
-    /**
-     * Get all courses in the hash table
-     * @return A vector of all courses
-     */
-    vector<Course> getAllCourses() {
-        vector<Course> allCourses;
+    size_t capacity() const {
+        return maxEntries;
+    }
 
-        // Iterate through all buckets
-        for (unsigned int i = 0; i < tableSize; ++i) {
-            Node* current = table[i];
+    size_t hits() const {
+        return hitCount;
+    }
 
-            // Traverse the chain and collect all courses
-            while (current != nullptr) {
-                allCourses.push_back(current->course);
-                current = current->next;
-            }
-        }
+    size_t misses() const {
+        return missCount;
+    }
 
-        return allCourses;
+    void swap(CourseDetailCache& other) {
+        entries.swap(other.entries);
+        index.swap(other.index);
+        std::swap(maxEntries, other.maxEntries);
+        std::swap(hitCount, other.hitCount);
+        std::swap(missCount, other.missCount);
     }
+
+private:
+    using Entry = pair<string, string>;
+
+    list<Entry> entries;   // Most recently used first
+    unordered_map<string, list<Entry>::iterator> index;
+    size_t maxEntries;
+    size_t hitCount = 0;
+    size_t missCount = 0;
+};
+
+//=============================================================================
+// Columnar Course Store
+//=============================================================================
+
 /**
- * Remove a course from the hash table
- * @param courseNumber The course number to remove
- * @return True if the course was removed, false if not found
+ * Structure-of-arrays copy of the catalog for scans
+ *
+ * Each row is one course. The key column holds key ids, titles are views
+ * of the stored courses' own titles (rows are only appended for courses
+ * held by the hash table's nodes, which never move, and a row is retired
+ * before its course changes) and prerequisites are key ids in CSR form (row r
+ * owns prerequisiteIds[prerequisiteStart[r] .. prerequisiteStart[r + 1])).
+ * Key ids come from a dictionary that also names prerequisites no stored
+ * course has, so a prerequisite scan compares integers and never touches
+ * a title. Rows are only ever appended; a changed or removed course
+ * retires its row and the dead rows are dropped when the store is rebuilt.
  */
-bool remove(const string& courseNumber) {
-    unsigned int index = hash(courseNumber);
-    Node* current = table[index];
-    Node* prev = nullptr;
+class CourseColumns {
+public:
+    static const uint32_t NO_KEY = numeric_limits<uint32_t>::max();
 
-    // Traverse the chain at this bucket
-    while (current != nullptr) {
-        if (current->course.courseNumber == courseNumber) {
-            // Course found, remove it
-            if (prev == nullptr) {
-                // Removing head of the chain
-                table[index] = current->next;
-            } else {
-                // Removing from middle or end of the chain
-                prev->next = current->next;
+    /**
+     * Append a course as a new row
+     * @param course The course to copy into the columns; its title must
+     *        stay in place while the row is live
+     * @return The row id
+     */
+    uint32_t appendRow(const Course& course) {
+        uint32_t row = static_cast<uint32_t>(rowKey.size());
+        rowKey.push_back(internKey(course.courseNumber));
+        titles.push_back(course.title());
+        for (const auto& prereq : course.prerequisites) {
+            prerequisiteIds.push_back(internKey(prereq));
+        }
+        prerequisiteStart.push_back(static_cast<uint32_t>(prerequisiteIds.size()));
+        live.push_back(1);
+        ++liveCount;
+        return row;
+    }
+
+    // Mark a row as no longer describing a stored course
+    void retireRow(uint32_t row) {
+        if (live[row]) {
+            live[row] = 0;
+            --liveCount;
+        }
+    }
+
+    /**
+     * Look up the id of a course number
+     * @param courseNumber The course number
+     * @return The key id, or NO_KEY if no row has ever used the number
+     */
+    uint32_t keyId(const string& courseNumber) const {
+        if (keySlots.empty()) {
+            return NO_KEY;
+        }
+        uint64_t keyHash = courseKeyHash(courseNumber);
+        for (size_t slot = keyHash & (keySlots.size() - 1); ; slot = (slot + 1) & (keySlots.size() - 1)) {
+            const KeySlot& entry = keySlots[slot];
+            if (entry.id == NO_KEY) {
+                return NO_KEY;
+            }
+            if (entry.hash == keyHash && keyText(entry.id) == courseNumber) {
+                return entry.id;
+            }
+        }
+    }
+
+    /**
+     * Rows of the live courses that list a key id as a prerequisite
+     * @param prerequisiteKey The key id to look for
+     * @return The matching row ids in row order
+     */
+    vector<uint32_t> rowsRequiring(uint32_t prerequisiteKey) const {
+        vector<uint32_t> rows;
+        if (prerequisiteKey == NO_KEY) {
+            return rows;
+        }
+        for (uint32_t row = 0; row < rowKey.size(); ++row) {
+            if (!live[row]) {
+                continue;
+            }
+            const uint32_t* first = prerequisiteIds.data() + prerequisiteStart[row];
+            const uint32_t* last = prerequisiteIds.data() + prerequisiteStart[row + 1];
+            if (std::find(first, last, prerequisiteKey) != last) {
+                rows.push_back(row);
+            }
+        }
+        return rows;
+    }
+
+    /**
+     * Row ids of the live courses, in row order
+     * @return The row ids
+     */
+    vector<uint32_t> liveRows() const {
+        vector<uint32_t> rows;
+        rows.reserve(liveCount);
+        for (uint32_t row = 0; row < rowKey.size(); ++row) {
+            if (live[row]) {
+                rows.push_back(row);
+            }
+        }
+        return rows;
+    }
+
+    string_view key(uint32_t row) const {
+        return keyText(rowKey[row]);
+    }
+
+    uint32_t rowKeyId(uint32_t row) const {
+        return rowKey[row];
+    }
+
+    // Key ids of a row's prerequisites, as a [first, last) range
+    pair<const uint32_t*, const uint32_t*> prerequisites(uint32_t row) const {
+        return {prerequisiteIds.data() + prerequisiteStart[row], prerequisiteIds.data() + prerequisiteStart[row + 1]};
+    }
+
+    size_t keyCount() const {
+        return keyStart.size() - 1;
+    }
+
+    string_view title(uint32_t row) const {
+        return titles[row];
+    }
+
+    string_view keyText(uint32_t id) const {
+        return string_view(keyBlob).substr(keyStart[id], keyStart[id + 1] - keyStart[id]);
+    }
+
+    size_t rowCount() const {
+        return rowKey.size();
+    }
+
+    size_t liveRowCount() const {
+        return liveCount;
+    }
+
+    /**
+     * Make room for a number of rows before a bulk append
+     * @param rows Expected number of rows (and of distinct keys)
+     */
+    void reserve(size_t rows) {
+        keyStart.reserve(rows + 1);
+        growKeySlots(rows);
+        rowKey.reserve(rows);
+        titles.reserve(rows);
+        prerequisiteStart.reserve(rows + 1);
+        live.reserve(rows);
+    }
+
+    void clear() {
+        keyBlob.clear();
+        keyStart.assign(1, 0);
+        keySlots.clear();
+        rowKey.clear();
+        titles.clear();
+        prerequisiteStart.assign(1, 0);
+        prerequisiteIds.clear();
+        live.clear();
+        liveCount = 0;
+    }
+
+    // Bytes reserved by all the columns, including unused capacity
+    size_t bytes() const {
+        return keyBlob.capacity() + titles.capacity() * sizeof(string_view) + keySlots.capacity() * sizeof(KeySlot) +
+               (keyStart.capacity() + rowKey.capacity() + prerequisiteStart.capacity() +
+                prerequisiteIds.capacity()) * sizeof(uint32_t) + live.capacity();
+    }
+
+    void swap(CourseColumns& other) {
+        keyBlob.swap(other.keyBlob);
+        keyStart.swap(other.keyStart);
+        keySlots.swap(other.keySlots);
+        rowKey.swap(other.rowKey);
+        titles.swap(other.titles);
+        prerequisiteStart.swap(other.prerequisiteStart);
+        prerequisiteIds.swap(other.prerequisiteIds);
+        live.swap(other.live);
+        std::swap(liveCount, other.liveCount);
+    }
+
+private:
+    struct KeySlot {
+        uint64_t hash;
+        uint32_t id;
+    };
+
+    /**
+     * Get the id of a course number, adding it to the dictionary if new
+     * @param courseNumber The course number
+     * @return The key id
+     */
+    uint32_t internKey(const string& courseNumber) {
+        uint32_t keyCount = static_cast<uint32_t>(keyStart.size() - 1);
+        growKeySlots(keyCount + 1);
+        uint64_t keyHash = courseKeyHash(courseNumber);
+        size_t slot = keyHash & (keySlots.size() - 1);
+        for (; keySlots[slot].id != NO_KEY; slot = (slot + 1) & (keySlots.size() - 1)) {
+            if (keySlots[slot].hash == keyHash && keyText(keySlots[slot].id) == courseNumber) {
+                return keySlots[slot].id;
+            }
+        }
+        keySlots[slot] = {keyHash, keyCount};
+        keyBlob += courseNumber;
+        keyStart.push_back(static_cast<uint32_t>(keyBlob.size()));
+        return keyCount;
+    }
+
+    // Keep the open-addressing table at most half full
+    void growKeySlots(size_t keyCount) {
+        if (keyCount * 2 <= keySlots.size()) {
+            return;
+        }
+        size_t slotCount = 64;
+        while (slotCount < keyCount * 2) {
+            slotCount *= 2;
+        }
+        vector<KeySlot> oldSlots(slotCount, KeySlot{0, NO_KEY});
+        oldSlots.swap(keySlots);
+        for (const KeySlot& entry : oldSlots) {
+            if (entry.id != NO_KEY) {
+                size_t slot = entry.hash & (slotCount - 1);
+                while (keySlots[slot].id != NO_KEY) {
+                    slot = (slot + 1) & (slotCount - 1);
+                }
+                keySlots[slot] = entry;
+            }
+        }
+    }
+
+    // Key dictionary: every course number seen, as offsets into one blob,
+    // found through an open-addressing table on courseKeyHash()
+    string keyBlob;
+    vector<uint32_t> keyStart{0};
+    vector<KeySlot> keySlots;
+
+    // Row columns
+    vector<uint32_t> rowKey;
+    vector<string_view> titles;
+    vector<uint32_t> prerequisiteStart{0};
+    vector<uint32_t> prerequisiteIds;
+    vector<uint8_t> live;
+    size_t liveCount = 0;
+};
+
+//=============================================================================
+// Eligibility Matrix
+//=============================================================================
+
+/**
+ * Prerequisite bit matrix for "which courses can this student take next"
+ *
+ * Course numbers are numbered densely by the column store's key ids, and
+ * a transcript is a bitset over those ids. Row r of the matrix is the
+ * bitset of course r's prerequisites. A full row would be one bit per
+ * course in the catalog (1.25 GB at 100,000 courses), so each row keeps
+ * only its nonzero 64-bit words, as (word index, mask) pairs in CSR form.
+ * A query ANDs every stored word against the transcript in one
+ * branch-free pass over contiguous arrays and then ORs the missing bits
+ * per row: a course is eligible when nothing is missing and it is not
+ * already on the transcript.
+ */
+class EligibilityMatrix {
+public:
+    /**
+     * Encode the live courses of a column store
+     * @param columns The column store (must not change while the matrix is used)
+     */
+    void build(const CourseColumns& columns) {
+        // Rows in course-number order, so results come out sorted
+        rows = columns.liveRows();
+        sortByCourseNumber(rows, [&columns](uint32_t row) { return columns.key(row); });
+        keyCount = columns.keyCount();
+        rowKeyIds.resize(rows.size());
+        rowStart.assign(1, 0);
+        rowStart.reserve(rows.size() + 1);
+        wordIndexes.clear();
+        wordMasks.clear();
+
+        vector<uint32_t> prereqs;
+        for (size_t r = 0; r < rows.size(); ++r) {
+            rowKeyIds[r] = columns.rowKeyId(rows[r]);
+            auto range = columns.prerequisites(rows[r]);
+            prereqs.assign(range.first, range.second);
+            sort(prereqs.begin(), prereqs.end());
+            // Prerequisites that share a word are merged into one mask
+            for (uint32_t id : prereqs) {
+                uint32_t word = id / 64;
+                if (wordIndexes.size() > rowStart.back() && wordIndexes.back() == word) {
+                    wordMasks.back() |= 1ull << (id % 64);
+                } else {
+                    wordIndexes.push_back(word);
+                    wordMasks.push_back(1ull << (id % 64));
+                }
+            }
+            rowStart.push_back(static_cast<uint32_t>(wordIndexes.size()));
+        }
+    }
+
+    /**
+     * Encode a transcript as a bitset over key ids
+     * @param completedKeyIds Key ids of the completed courses (CourseColumns::NO_KEY is skipped)
+     * @return The transcript bitset
+     */
+    vector<uint64_t> transcriptBits(const vector<uint32_t>& completedKeyIds) const {
+        vector<uint64_t> bits((keyCount + 63) / 64, 0);
+        for (uint32_t id : completedKeyIds) {
+            if (id < keyCount) {
+                bits[id / 64] |= 1ull << (id % 64);
+            }
+        }
+        return bits;
+    }
+
+    /**
+     * Find the courses a transcript makes eligible
+     * @param transcript Bitset from transcriptBits()
+     * @param eligible Receives the column store row ids of the eligible courses, in course-number order
+     * @param missing Scratch space, reused across queries
+     */
+    void eligibleRows(const vector<uint64_t>& transcript, vector<uint32_t>& eligible, vector<uint64_t>& missing) const {
+        const size_t wordCount = wordIndexes.size();
+        missing.resize(wordCount);
+        const uint32_t* index = wordIndexes.data();
+        const uint64_t* mask = wordMasks.data();
+        const uint64_t* have = transcript.data();
+        uint64_t* gap = missing.data();
+        for (size_t w = 0; w < wordCount; ++w) {
+            gap[w] = mask[w] & ~have[index[w]];
+        }
+
+        eligible.clear();
+        for (size_t r = 0; r < rows.size(); ++r) {
+            uint64_t rowGap = 0;
+            for (uint32_t w = rowStart[r]; w < rowStart[r + 1]; ++w) {
+                rowGap |= gap[w];
+            }
+            uint32_t id = rowKeyIds[r];
+            rowGap |= (have[id / 64] >> (id % 64)) & 1;   // Already completed
+            if (rowGap == 0) {
+                eligible.push_back(rows[r]);
+            }
+        }
+    }
+
+    size_t rowCount() const {
+        return rows.size();
+    }
+
+    // Stored words and masks, for sizing reports
+    size_t bytes() const {
+        return wordIndexes.size() * (sizeof(uint32_t) + sizeof(uint64_t)) + rowStart.size() * sizeof(uint32_t)
+               + rows.size() * 2 * sizeof(uint32_t);
+    }
+
+private:
+    vector<uint32_t> rows;         // Column store row of each matrix row
+    vector<uint32_t> rowKeyIds;    // Key id of each matrix row's course
+    vector<uint32_t> rowStart;     // CSR offsets into the word arrays
+    vector<uint32_t> wordIndexes;  // Which 64-bit word of the row's bitset
+    vector<uint64_t> wordMasks;    // The nonzero bits of that word
+    size_t keyCount = 0;
+};
+
+//=============================================================================
+// Department Index
+//=============================================================================
+
+/**
+ * Courses grouped by department prefix ("CSCI", "MATH"), each department
+ * kept sorted by course level (the number after the prefix) and then by
+ * course number. A department listing or a level range such as CSCI
+ * 300-399 is two binary searches plus the courses returned, instead of a
+ * scan and sort of the whole catalog.
+ *
+ * The index holds pointers to courses owned by the hash table, whose
+ * nodes never move. Adds append to their department and leave it
+ * unsorted until prepare(), which sorts the unsorted departments in
+ * parallel; a removal is a search and erase within its department.
+ */
+class DepartmentIndex {
+public:
+    // One course in a department, with its level parsed once
+    struct Entry {
+        uint32_t level;
+        const Course* course;
+    };
+
+    // The courses returned by a query, in order
+    struct Range {
+        const Entry* first = nullptr;
+        const Entry* last = nullptr;
+
+        const Entry* begin() const { return first; }
+        const Entry* end() const { return last; }
+        size_t size() const { return static_cast<size_t>(last - first); }
+    };
+
+    // The letters a course number starts with
+    static string_view departmentOf(string_view courseNumber) {
+        size_t length = 0;
+        while (length < courseNumber.size() && isalpha(static_cast<unsigned char>(courseNumber[length]))) {
+            ++length;
+        }
+        return courseNumber.substr(0, length);
+    }
+
+    // The number after the department prefix (CSCI301L is level 301), or 0
+    static uint32_t levelOf(string_view courseNumber) {
+        uint32_t level = 0;
+        size_t digits = 0;
+        for (size_t i = departmentOf(courseNumber).size(); i < courseNumber.size() && digits < 9; ++i, ++digits) {
+            char ch = courseNumber[i];
+            if (ch < '0' || ch > '9') {
+                break;
+            }
+            level = level * 10 + static_cast<uint32_t>(ch - '0');
+        }
+        return level;
+    }
+
+    /**
+     * Rebuild the index from scratch: group the courses by department on
+     * this thread, then sort the departments on up to threadCount threads
+     * @param courses The courses to index
+     * @param threadCount Number of threads to sort departments on
+     */
+    void build(const vector<const Course*>& courses, unsigned int threadCount) {
+        clear();
+        Partition* current = nullptr;
+        for (const Course* course : courses) {
+            string_view department = departmentOf(course->courseNumber);
+            // Catalog files are usually grouped by department, so the last
+            // department looked up is the likely one
+            if (current == nullptr || current->name != department) {
+                current = &partitionFor(department);
+            }
+            current->entries.push_back(Entry{levelOf(course->courseNumber), course});
+            current->sorted = false;
+        }
+        prepare(threadCount);
+    }
+
+    // Index a newly stored course
+    void add(const Course& course) {
+        Partition& partition = partitionFor(departmentOf(course.courseNumber));
+        Entry entry{levelOf(course.courseNumber), &course};
+        // Keep the department sorted when courses arrive in order
+        if (partition.sorted && !partition.entries.empty() && entryLess(entry, partition.entries.back())) {
+            partition.sorted = false;
+        }
+        partition.entries.push_back(entry);
+    }
+
+    // Drop a course that is about to be removed from the table
+    void remove(const Course& course) {
+        auto found = partitionIndex.find(string(departmentOf(course.courseNumber)));
+        if (found == partitionIndex.end()) {
+            return;
+        }
+        vector<Entry>& entries = partitions[found->second].entries;
+        auto position = entries.end();
+        if (partitions[found->second].sorted) {
+            Entry key{levelOf(course.courseNumber), &course};
+            position = lower_bound(entries.begin(), entries.end(), key, entryLess);
+            if (position != entries.end() && position->course != &course) {
+                position = entries.end();
+            }
+        } else {
+            position = find_if(entries.begin(), entries.end(), [&course](const Entry& entry) { return entry.course == &course; });
+        }
+        if (position != entries.end()) {
+            entries.erase(position);
+        }
+    }
+
+    /**
+     * Sort every department changed since the last call, largest first,
+     * spread across threads
+     * @param threadCount Number of threads to sort on
+     */
+    void prepare(unsigned int threadCount) {
+        vector<Partition*> unsorted;
+        for (auto& partition : partitions) {
+            if (!partition.sorted) {
+                unsorted.push_back(&partition);
+            }
+        }
+        if (unsorted.empty()) {
+            return;
+        }
+        sort(unsorted.begin(), unsorted.end(),
+             [](const Partition* a, const Partition* b) { return a->entries.size() > b->entries.size(); });
+
+        atomic<size_t> next(0);
+        auto sortPartitions = [&unsorted, &next]() {
+            for (size_t i = next++; i < unsorted.size(); i = next++) {
+                vector<Entry>& entries = unsorted[i]->entries;
+                sort(entries.begin(), entries.end(), entryLess);
+                unsorted[i]->sorted = true;
+            }
+        };
+        threadCount = static_cast<unsigned int>(max<size_t>(1, min<size_t>(threadCount, unsorted.size())));
+        vector<thread> workers;
+        for (unsigned int worker = 1; worker < threadCount; ++worker) {
+            workers.emplace_back(sortPartitions);
+        }
+        sortPartitions();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    /**
+     * Courses of one department with levels in [lowLevel, highLevel];
+     * only valid after prepare()
+     * @param department The department prefix, uppercase
+     * @param lowLevel Lowest course level to return
+     * @param highLevel Highest course level to return
+     * @return The courses, ordered by level then course number
+     */
+    Range range(string_view department, uint32_t lowLevel = 0, uint32_t highLevel = UINT32_MAX) const {
+        Range result;
+        auto found = partitionIndex.find(string(department));
+        if (found == partitionIndex.end() || lowLevel > highLevel) {
+            return result;
+        }
+        const vector<Entry>& entries = partitions[found->second].entries;
+        auto byLevel = [](const Entry& entry, uint32_t level) { return entry.level < level; };
+        auto first = lower_bound(entries.begin(), entries.end(), lowLevel, byLevel);
+        auto last = highLevel == UINT32_MAX ? entries.end()
+                                           : lower_bound(first, entries.end(), highLevel + 1, byLevel);
+        result.first = entries.data() + (first - entries.begin());
+        result.last = entries.data() + (last - entries.begin());
+        return result;
+    }
+
+    /**
+     * Every department and its course count, by name
+     * @return (name, count) pairs; departments emptied by removals are skipped
+     */
+    vector<pair<string, size_t>> departments() const {
+        vector<pair<string, size_t>> result;
+        for (const auto& partition : partitions) {
+            if (!partition.entries.empty()) {
+                result.emplace_back(partition.name, partition.entries.size());
+            }
+        }
+        sort(result.begin(), result.end());
+        return result;
+    }
+
+    size_t bytes() const {
+        size_t total = partitions.size() * sizeof(Partition);
+        for (const auto& partition : partitions) {
+            total += partition.entries.capacity() * sizeof(Entry) + partition.name.capacity();
+        }
+        return total;
+    }
+
+    void clear() {
+        partitions.clear();
+        partitionIndex.clear();
+    }
+
+    void swap(DepartmentIndex& other) {
+        partitions.swap(other.partitions);
+        partitionIndex.swap(other.partitionIndex);
+    }
+
+private:
+    struct Partition {
+        string name;
+        vector<Entry> entries;
+        bool sorted = true;
+    };
+
+    // deque, so that a Partition& stays valid while new departments are added
+    deque<Partition> partitions;
+    unordered_map<string, size_t> partitionIndex;
+
+    static bool entryLess(const Entry& a, const Entry& b) {
+        if (a.level != b.level) {
+            return a.level < b.level;
+        }
+        return a.course->courseNumber < b.course->courseNumber;
+    }
+
+    Partition& partitionFor(string_view department) {
+        auto inserted = partitionIndex.emplace(string(department), partitions.size());
+        if (inserted.second) {
+            partitions.emplace_back();
+            partitions.back().name = string(department);
+        }
+        return partitions[inserted.first->second];
+    }
+};
+
+//=============================================================================
+// Prerequisite Chains
+//=============================================================================
+
+/**
+ * Longest prerequisite chains through the catalog, for curriculum planning
+ *
+ * A course's depth is the earliest term it can be taken in: 1 with no
+ * prerequisites, otherwise one more than its deepest prerequisite. Its
+ * height is the longest chain of courses that starts with it and
+ * continues through courses that require it. The longest chain in the
+ * catalog is the largest depth, and a course is on a critical path when
+ * depth + height - 1 equals it: delaying that course delays the end of
+ * the longest chain.
+ *
+ * build() numbers every course and computes both values in O(courses +
+ * prerequisites) with a level-synchronous topological pass: each level's
+ * courses are processed on several threads, which count down their
+ * dependents' remaining prerequisites atomically, and heights are filled
+ * in level by level on the way back. Afterwards, update() records an
+ * added, changed or removed course and applyUpdates() recomputes depths
+ * only for the courses downstream of the changes and heights only for
+ * those upstream of them. Courses caught in (or behind) a prerequisite
+ * cycle have depth 0 and no height; while any exist, updates recompute
+ * everything.
+ */
+class PrerequisiteChains {
+public:
+    // A course's place in the chains
+    struct CourseChain {
+        uint32_t depth = 0;
+        uint32_t height = 0;
+        bool critical = false;
+    };
+
+    /**
+     * Rebuild from scratch
+     * @param courses The stored courses
+     * @param threadCount Number of threads to process each level on
+     */
+    void build(const vector<const Course*>& courses, unsigned int threadCount) {
+        clear();
+        growNodeSlots(courses.size());
+        // Courses are nodes 0..n-1 in order; prerequisites that are not
+        // stored get the nodes after them. Every node is added before any
+        // per-node list is touched, since nodeFor() grows those vectors.
+        for (const Course* course : courses) {
+            uint32_t node = nodeFor(course->courseNumber);
+            present[node] = 1;
+        }
+        for (const Course* course : courses) {
+            for (const auto& prereq : course->prerequisites) {
+                nodeFor(prereq);
+            }
+        }
+        for (uint32_t node = 0; node < courses.size(); ++node) {
+            const vector<string>& prereqs = courses[node]->prerequisites;
+            vector<uint32_t>& prereqNodes = prerequisites[node];
+            prereqNodes.reserve(prereqs.size());
+            for (const auto& prereq : prereqs) {
+                prereqNodes.push_back(findNode(prereq));
+            }
+        }
+        // Size every dependent list before filling it
+        vector<uint32_t> dependentCounts(present.size(), 0);
+        for (const auto& prereqs : prerequisites) {
+            for (uint32_t prereq : prereqs) {
+                ++dependentCounts[prereq];
+            }
+        }
+        for (uint32_t node = 0; node < present.size(); ++node) {
+            dependents[node].reserve(dependentCounts[node]);
+        }
+        for (uint32_t node = 0; node < prerequisites.size(); ++node) {
+            for (uint32_t prereq : prerequisites[node]) {
+                dependents[prereq].push_back(node);
+            }
+        }
+        recomputeAll(threadCount);
+    }
+
+    /**
+     * Record a course that was added, changed or removed since the last
+     * applyUpdates(); the depths and heights it affects are stale until then
+     * @param courseNumber The course number
+     * @param course The stored course, or nullptr if it was removed
+     */
+    void update(const string& courseNumber, const Course* course) {
+        uint32_t node = nodeFor(courseNumber);
+        if (present[node] == (course != nullptr) && course != nullptr &&
+            sameNodes(prerequisites[node], course->prerequisites)) {
+            // Only the title changed
+            return;
+        }
+        if (present[node]) {
+            --depthCounts[depth[node]];
+        }
+        for (uint32_t prereq : prerequisites[node]) {
+            vector<uint32_t>& list = dependents[prereq];
+            list.erase(std::find(list.begin(), list.end(), node));
+            heightSeeds.push_back(prereq);
+        }
+        prerequisites[node].clear();
+        present[node] = course != nullptr;
+        depth[node] = 0;
+        height[node] = 0;
+        if (course != nullptr) {
+            // Counted as depth 0 until applyUpdates() computes the real depth
+            ++depthCounts[0];
+            linkPrerequisites(node, *course);
+            heightSeeds.insert(heightSeeds.end(), prerequisites[node].begin(), prerequisites[node].end());
+        }
+        depthSeeds.push_back(node);
+        heightSeeds.push_back(node);
+    }
+
+    /**
+     * Bring depths and heights up to date after update() calls
+     * @param threadCount Number of threads for a full recomputation
+     */
+    void applyUpdates(unsigned int threadCount) {
+        if (depthSeeds.empty()) {
+            return;
+        }
+        // Heights around a cycle (one just made or one that was there) are
+        // not confined to the closures below
+        if (hasCycles) {
+            recomputeAll(threadCount);
+            return;
+        }
+        size_t touched = updateDepths();
+        if (depthCounts[0] != 0) {
+            recomputeAll(threadCount);
+            return;
+        }
+        touched += updateHeights();
+        depthSeeds.clear();
+        heightSeeds.clear();
+        trimDepthCounts();
+        lastUpdate = touched;
+    }
+
+    /**
+     * Look up one course
+     * @param courseNumber The course number
+     * @param chain Set to the course's depth, height and critical flag
+     * @return False if the course is not stored
+     */
+    bool find(const string& courseNumber, CourseChain& chain) const {
+        uint32_t node = findNode(courseNumber);
+        if (node == NO_NODE || !present[node]) {
+            return false;
+        }
+        chain = chainOf(node);
+        return true;
+    }
+
+    // Length of the longest prerequisite chain (the number of terms it takes)
+    uint32_t longestChain() const {
+        return static_cast<uint32_t>(depthCounts.size() - 1);
+    }
+
+    // Stored courses per depth; entry 0 counts courses in or behind a cycle
+    const vector<size_t>& coursesByDepth() const {
+        return depthCounts;
+    }
+
+    /**
+     * Every course on a critical path, by depth and then course number
+     * @return The course numbers
+     */
+    vector<string> criticalCourses() const {
+        vector<uint32_t> nodes;
+        for (uint32_t node = 0; node < present.size(); ++node) {
+            if (chainOf(node).critical) {
+                nodes.push_back(node);
+            }
+        }
+        sort(nodes.begin(), nodes.end(), [this](uint32_t a, uint32_t b) {
+            return depth[a] != depth[b] ? depth[a] < depth[b] : names[a] < names[b];
+        });
+        vector<string> result;
+        result.reserve(nodes.size());
+        for (uint32_t node : nodes) {
+            result.push_back(names[node]);
+        }
+        return result;
+    }
+
+    /**
+     * One longest chain through a course, from a course without
+     * prerequisites to one nothing requires
+     * @param courseNumber The course, or "" for a longest chain in the catalog
+     * @return The course numbers in order, or nothing if the course is not
+     *         stored or is caught in a cycle
+     */
+    vector<string> longestChainThrough(const string& courseNumber) const {
+        uint32_t node = NO_NODE;
+        if (courseNumber.empty()) {
+            // The first critical course without prerequisites, by name
+            for (uint32_t candidate = 0; candidate < present.size(); ++candidate) {
+                if (chainOf(candidate).critical && depth[candidate] == 1 &&
+                    (node == NO_NODE || names[candidate] < names[node])) {
+                    node = candidate;
+                }
+            }
+        } else {
+            node = findNode(courseNumber);
+        }
+        vector<string> chain;
+        if (node == NO_NODE || !present[node] || depth[node] == 0) {
+            return chain;
+        }
+        for (uint32_t current = node; ;) {
+            chain.push_back(names[current]);
+            uint32_t next = NO_NODE;
+            for (uint32_t prereq : prerequisites[current]) {
+                if (present[prereq] && depth[prereq] + 1 == depth[current]) {
+                    next = prereq;
+                    break;
+                }
+            }
+            if (next == NO_NODE) {
+                break;
+            }
+            current = next;
+        }
+        reverse(chain.begin(), chain.end());
+        for (uint32_t current = node; ;) {
+            uint32_t next = NO_NODE;
+            for (uint32_t dependent : dependents[current]) {
+                if (present[dependent] && height[dependent] + 1 == height[current]) {
+                    next = dependent;
+                    break;
+                }
+            }
+            if (next == NO_NODE) {
+                break;
+            }
+            chain.push_back(names[next]);
+            current = next;
+        }
+        return chain;
+    }
+
+    // Courses whose depth or height the last incremental update recomputed
+    size_t lastUpdateSize() const {
+        return lastUpdate;
+    }
+
+    void clear() {
+        nodeSlots.clear();
+        names.clear();
+        present.clear();
+        prerequisites.clear();
+        dependents.clear();
+        depth.clear();
+        height.clear();
+        depthCounts.assign(1, 0);
+        depthSeeds.clear();
+        heightSeeds.clear();
+        visitMark.clear();
+        visitStamp = 0;
+        pending.clear();
+        hasCycles = false;
+        lastUpdate = 0;
+    }
+
+    void swap(PrerequisiteChains& other) {
+        nodeSlots.swap(other.nodeSlots);
+        names.swap(other.names);
+        present.swap(other.present);
+        prerequisites.swap(other.prerequisites);
+        dependents.swap(other.dependents);
+        depth.swap(other.depth);
+        height.swap(other.height);
+        depthCounts.swap(other.depthCounts);
+        depthSeeds.swap(other.depthSeeds);
+        heightSeeds.swap(other.heightSeeds);
+        visitMark.swap(other.visitMark);
+        std::swap(visitStamp, other.visitStamp);
+        pending.swap(other.pending);
+        std::swap(hasCycles, other.hasCycles);
+        std::swap(lastUpdate, other.lastUpdate);
+    }
+
+private:
+    static const uint32_t NO_NODE = numeric_limits<uint32_t>::max();
+    // Levels smaller than this are processed on the calling thread
+    static const size_t PARALLEL_LEVEL_SIZE = 8192;
+
+    struct NodeSlot {
+        uint64_t hash;
+        uint32_t node;
+    };
+
+    // Course numbers (stored or only named as prerequisites) by node id,
+    // found through an open-addressing table on courseKeyHash()
+    vector<NodeSlot> nodeSlots;
+    vector<string> names;
+    vector<uint8_t> present; // Whether the course is stored
+    vector<vector<uint32_t>> prerequisites;
+    vector<vector<uint32_t>> dependents;
+    vector<uint32_t> depth;
+    vector<uint32_t> height;
+    vector<size_t> depthCounts{0}; // Stored courses per depth, no trailing zeros past [0]
+    vector<uint32_t> depthSeeds; // Changed since applyUpdates(): recompute these and everything downstream
+    vector<uint32_t> heightSeeds; // ... and these and everything upstream
+    vector<uint32_t> visitMark; // Scratch for the incremental passes
+    uint32_t visitStamp = 0;
+    vector<uint32_t> pending;
+    bool hasCycles = false; // Some stored course has depth 0
+    size_t lastUpdate = 0;
+
+    CourseChain chainOf(uint32_t node) const {
+        CourseChain chain;
+        if (present[node] && depth[node] != 0) {
+            chain.depth = depth[node];
+            chain.height = height[node];
+            chain.critical = depth[node] + height[node] - 1 == longestChain();
+        }
+        return chain;
+    }
+
+    uint32_t findNode(string_view courseNumber) const {
+        if (nodeSlots.empty()) {
+            return NO_NODE;
+        }
+        uint64_t keyHash = courseKeyHash(courseNumber);
+        for (size_t slot = keyHash & (nodeSlots.size() - 1); ; slot = (slot + 1) & (nodeSlots.size() - 1)) {
+            const NodeSlot& entry = nodeSlots[slot];
+            if (entry.node == NO_NODE || (entry.hash == keyHash && names[entry.node] == courseNumber)) {
+                return entry.node;
+            }
+        }
+    }
+
+    // Get the node of a course number, adding one if it is new
+    uint32_t nodeFor(string_view courseNumber) {
+        growNodeSlots(names.size() + 1);
+        uint64_t keyHash = courseKeyHash(courseNumber);
+        size_t slot = keyHash & (nodeSlots.size() - 1);
+        for (; nodeSlots[slot].node != NO_NODE; slot = (slot + 1) & (nodeSlots.size() - 1)) {
+            if (nodeSlots[slot].hash == keyHash && names[nodeSlots[slot].node] == courseNumber) {
+                return nodeSlots[slot].node;
+            }
+        }
+        uint32_t node = static_cast<uint32_t>(names.size());
+        nodeSlots[slot] = {keyHash, node};
+        names.emplace_back(courseNumber);
+        present.push_back(0);
+        prerequisites.emplace_back();
+        dependents.emplace_back();
+        depth.push_back(0);
+        height.push_back(0);
+        visitMark.push_back(0);
+        return node;
+    }
+
+    // Keep the open-addressing table at most half full
+    void growNodeSlots(size_t nodeCount) {
+        if (nodeCount * 2 <= nodeSlots.size()) {
+            return;
+        }
+        size_t slotCount = 64;
+        while (slotCount < nodeCount * 2) {
+            slotCount *= 2;
+        }
+        vector<NodeSlot> oldSlots(slotCount, NodeSlot{0, NO_NODE});
+        oldSlots.swap(nodeSlots);
+        for (const NodeSlot& entry : oldSlots) {
+            if (entry.node != NO_NODE) {
+                size_t slot = entry.hash & (slotCount - 1);
+                while (nodeSlots[slot].node != NO_NODE) {
+                    slot = (slot + 1) & (slotCount - 1);
+                }
+                nodeSlots[slot] = entry;
+            }
+        }
+    }
+
+    void linkPrerequisites(uint32_t node, const Course& course) {
+        prerequisites[node].reserve(course.prerequisites.size());
+        for (const auto& prereq : course.prerequisites) {
+            uint32_t prereqNode = nodeFor(prereq);
+            prerequisites[node].push_back(prereqNode);
+            dependents[prereqNode].push_back(node);
+        }
+    }
+
+    bool sameNodes(const vector<uint32_t>& nodes, const vector<string>& courseNumbers) const {
+        if (nodes.size() != courseNumbers.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            if (names[nodes[i]] != courseNumbers[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void trimDepthCounts() {
+        while (depthCounts.size() > 1 && depthCounts.back() == 0) {
+            depthCounts.pop_back();
+        }
+    }
+
+    void countDepth(uint32_t value) {
+        if (depthCounts.size() <= value) {
+            depthCounts.resize(value + 1, 0);
+        }
+        ++depthCounts[value];
+    }
+
+    // Start a new visit; marks equal to the returned stamp belong to it
+    uint32_t newVisit() {
+        if (++visitStamp == 0) {
+            fill(visitMark.begin(), visitMark.end(), 0);
+            visitStamp = 1;
+        }
+        return visitStamp;
+    }
+
+    /**
+     * Run work(first, last, worker) over slices of [0, count): one slice
+     * per thread for large levels, one slice on this thread otherwise
+     * @return Number of workers used
+     */
+    template <typename Work>
+    static unsigned int forEachSlice(size_t count, unsigned int threadCount, Work work) {
+        unsigned int workers = count >= PARALLEL_LEVEL_SIZE ? max(1u, threadCount) : 1;
+        vector<thread> threads;
+        for (unsigned int worker = 1; worker < workers; ++worker) {
+            threads.emplace_back(work, count * worker / workers, count * (worker + 1) / workers, worker);
+        }
+        work(size_t(0), count / workers, 0u);
+        for (auto& worker : threads) {
+            worker.join();
+        }
+        return workers;
+    }
+
+    // Level-synchronous topological pass over the whole graph
+    void recomputeAll(unsigned int threadCount) {
+        const size_t nodeCount = present.size();
+        threadCount = max(1u, threadCount);
+        unique_ptr<atomic<uint32_t>[]> remaining(new atomic<uint32_t>[nodeCount]);
+        vector<vector<uint32_t>> found(threadCount);
+        forEachSlice(nodeCount, threadCount, [&](size_t first, size_t last, unsigned int worker) {
+            for (size_t node = first; node < last; ++node) {
+                uint32_t count = 0;
+                for (uint32_t prereq : prerequisites[node]) {
+                    count += present[prereq];
+                }
+                remaining[node].store(count, memory_order_relaxed);
+                depth[node] = 0;
+                height[node] = 0;
+                if (present[node] && count == 0) {
+                    found[worker].push_back(static_cast<uint32_t>(node));
+                }
+            }
+        });
+
+        // Depths, one level at a time; a course joins the next level when
+        // its last prerequisite is processed
+        vector<vector<uint32_t>> levels;
+        vector<uint32_t> frontier;
+        for (auto& nodes : found) {
+            frontier.insert(frontier.end(), nodes.begin(), nodes.end());
+            nodes.clear();
+        }
+        while (!frontier.empty()) {
+            uint32_t level = static_cast<uint32_t>(levels.size() + 1);
+            forEachSlice(frontier.size(), threadCount, [&](size_t first, size_t last, unsigned int worker) {
+                for (size_t i = first; i < last; ++i) {
+                    uint32_t node = frontier[i];
+                    depth[node] = level;
+                    for (uint32_t dependent : dependents[node]) {
+                        if (present[dependent] && remaining[dependent].fetch_sub(1, memory_order_acq_rel) == 1) {
+                            found[worker].push_back(dependent);
+                        }
+                    }
+                }
+            });
+            levels.push_back(std::move(frontier));
+            frontier.clear();
+            for (auto& nodes : found) {
+                frontier.insert(frontier.end(), nodes.begin(), nodes.end());
+                nodes.clear();
+            }
+        }
+
+        // Heights, deepest level first: a course's dependents are all deeper
+        for (size_t level = levels.size(); level-- > 0;) {
+            const vector<uint32_t>& nodes = levels[level];
+            forEachSlice(nodes.size(), threadCount, [&](size_t first, size_t last, unsigned int) {
+                for (size_t i = first; i < last; ++i) {
+                    height[nodes[i]] = 1 + tallestDependent(nodes[i]);
+                }
+            });
+        }
+
+        depthCounts.assign(levels.size() + 1, 0);
+        for (size_t level = 0; level < levels.size(); ++level) {
+            depthCounts[level + 1] = levels[level].size();
+        }
+        size_t stored = 0;
+        for (uint8_t flag : present) {
+            stored += flag;
+        }
+        // Courses never reached are in or behind a cycle
+        for (const auto& nodes : levels) {
+            stored -= nodes.size();
+        }
+        depthCounts[0] = stored;
+        hasCycles = stored != 0;
+        trimDepthCounts();
+        depthSeeds.clear();
+        heightSeeds.clear();
+        lastUpdate = nodeCount;
+    }
+
+    uint32_t tallestDependent(uint32_t node) const {
+        uint32_t tallest = 0;
+        for (uint32_t dependent : dependents[node]) {
+            if (present[dependent] && depth[dependent] != 0) {
+                tallest = max(tallest, height[dependent]);
+            }
+        }
+        return tallest;
+    }
+
+    /**
+     * Recompute depths downstream of depthSeeds, in topological order
+     * within that set; courses outside it keep their depths
+     * @return Number of courses visited
+     */
+    size_t updateDepths() {
+        uint32_t stamp = newVisit();
+        vector<uint32_t> affected;
+        for (uint32_t seed : depthSeeds) {
+            if (visitMark[seed] != stamp) {
+                visitMark[seed] = stamp;
+                affected.push_back(seed);
+            }
+        }
+        for (size_t i = 0; i < affected.size(); ++i) {
+            for (uint32_t dependent : dependents[affected[i]]) {
+                if (visitMark[dependent] != stamp) {
+                    visitMark[dependent] = stamp;
+                    affected.push_back(dependent);
+                }
+            }
+        }
+
+        // Count each affected course's prerequisites that are affected too
+        pending.resize(present.size());
+        vector<uint32_t> ready;
+        for (uint32_t node : affected) {
+            uint32_t count = 0;
+            for (uint32_t prereq : prerequisites[node]) {
+                count += present[prereq] && visitMark[prereq] == stamp;
+            }
+            pending[node] = count;
+            if (present[node] && count == 0) {
+                ready.push_back(node);
+            }
+        }
+        while (!ready.empty()) {
+            uint32_t node = ready.back();
+            ready.pop_back();
+            uint32_t newDepth = 1;
+            for (uint32_t prereq : prerequisites[node]) {
+                if (present[prereq]) {
+                    // A prerequisite in a cycle puts this course behind it
+                    newDepth = depth[prereq] == 0 ? 0 : max(newDepth, depth[prereq] + 1);
+                    if (newDepth == 0) {
+                        break;
+                    }
+                }
+            }
+            if (newDepth != depth[node]) {
+                --depthCounts[depth[node]];
+                countDepth(newDepth);
+                depth[node] = newDepth;
+            }
+            for (uint32_t dependent : dependents[node]) {
+                if (present[dependent] && visitMark[dependent] == stamp && --pending[dependent] == 0) {
+                    ready.push_back(dependent);
+                }
+            }
+        }
+        // Present courses that were never settled are in a cycle; their
+        // depth stays 0 and depthCounts[0] records them
+        for (uint32_t node : affected) {
+            if (present[node] && pending[node] != 0 && depth[node] != 0) {
+                --depthCounts[depth[node]];
+                ++depthCounts[0];
+                depth[node] = 0;
+            }
+        }
+        return affected.size();
+    }
+
+    /**
+     * Recompute heights upstream of heightSeeds, dependents first
+     * @return Number of courses visited
+     */
+    size_t updateHeights() {
+        uint32_t stamp = newVisit();
+        vector<uint32_t> affected;
+        for (uint32_t seed : heightSeeds) {
+            if (visitMark[seed] != stamp) {
+                visitMark[seed] = stamp;
+                affected.push_back(seed);
+            }
+        }
+        for (size_t i = 0; i < affected.size(); ++i) {
+            for (uint32_t prereq : prerequisites[affected[i]]) {
+                if (visitMark[prereq] != stamp) {
+                    visitMark[prereq] = stamp;
+                    affected.push_back(prereq);
+                }
+            }
+        }
+
+        pending.resize(present.size());
+        vector<uint32_t> ready;
+        for (uint32_t node : affected) {
+            uint32_t count = 0;
+            for (uint32_t dependent : dependents[node]) {
+                count += present[dependent] && visitMark[dependent] == stamp;
+            }
+            pending[node] = count;
+            if (count == 0) {
+                ready.push_back(node);
+            }
+        }
+        while (!ready.empty()) {
+            uint32_t node = ready.back();
+            ready.pop_back();
+            height[node] = present[node] ? 1 + tallestDependent(node) : 0;
+            for (uint32_t prereq : prerequisites[node]) {
+                if (visitMark[prereq] == stamp && --pending[prereq] == 0) {
+                    ready.push_back(prereq);
+                }
+            }
+        }
+        return affected.size();
+    }
+};
+
+//=============================================================================
+// Pipeline Queue
+//=============================================================================
+
+/**
+ * Fixed-capacity queue between pipeline threads
+ * push() blocks while the queue is full and pop() while it is empty, so
+ * a fast stage can never run more than the capacity ahead of a slow one.
+ */
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) : maxItems(capacity) {}
+
+    void push(T item) {
+        unique_lock<mutex> lock(guard);
+        notFull.wait(lock, [this]() { return items.size() < maxItems; });
+        items.push_back(std::move(item));
+        notEmpty.notify_one();
+    }
+
+    /**
+     * Take the oldest item
+     * @param item Receives the item
+     * @return False once the queue is closed and drained
+     */
+    bool pop(T& item) {
+        unique_lock<mutex> lock(guard);
+        notEmpty.wait(lock, [this]() { return !items.empty() || closed; });
+        if (items.empty()) {
+            return false;
+        }
+        item = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    // No more pushes; consumers drain what is left and then stop
+    void close() {
+        lock_guard<mutex> lock(guard);
+        closed = true;
+        notEmpty.notify_all();
+    }
+
+private:
+    mutex guard;
+    condition_variable notEmpty;
+    condition_variable notFull;
+    deque<T> items;
+    size_t maxItems;
+    bool closed = false;
+};
+
+//=============================================================================
+// Mapped Catalog Files
+//=============================================================================
+
+/**
+ * A catalog file mapped read-only into memory, so that a lazy load can
+ * leave every title as a view into the file instead of a heap string.
+ * The OS pages titles in only when a listing, export or course lookup
+ * reads them. Without mmap (Windows) the file is read into one buffer,
+ * which still saves a heap string per course.
+ */
+class MappedCatalogFile {
+public:
+    MappedCatalogFile() = default;
+    MappedCatalogFile(const MappedCatalogFile&) = delete;
+    MappedCatalogFile& operator=(const MappedCatalogFile&) = delete;
+
+    ~MappedCatalogFile() {
+#ifndef _WIN32
+        if (mapped) {
+            munmap(const_cast<char*>(data), length);
+        }
+#endif
+    }
+
+    /**
+     * Map a file
+     * @param filename Path to the file
+     * @return False if the file could not be opened or mapped
+     */
+    bool open(const string& filename) {
+#ifdef _WIN32
+        ifstream file(filename, ios::binary);
+        if (!file.is_open()) {
+            return false;
+        }
+        contents.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+        data = contents.data();
+        length = contents.size();
+        return true;
+#else
+        int descriptor = ::open(filename.c_str(), O_RDONLY);
+        if (descriptor < 0) {
+            return false;
+        }
+        struct stat info;
+        if (fstat(descriptor, &info) != 0) {
+            ::close(descriptor);
+            return false;
+        }
+        length = static_cast<size_t>(info.st_size);
+        if (length > 0) {
+            void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if (address == MAP_FAILED) {
+                ::close(descriptor);
+                return false;
+            }
+            data = static_cast<const char*>(address);
+            mapped = true;
+        }
+        // The mapping stays valid after the descriptor is closed
+        ::close(descriptor);
+        return true;
+#endif
+    }
+
+    string_view text() const {
+        return string_view(data, length);
+    }
+
+    // Let the OS drop the pages read so far; they are read back from the
+    // file when a title on them is next needed
+    void releaseResidentPages() const {
+#ifndef _WIN32
+        if (mapped) {
+            madvise(const_cast<char*>(data), length, MADV_DONTNEED);
+        }
+#endif
+    }
+
+    size_t size() const {
+        return length;
+    }
+
+private:
+    const char* data = "";
+    size_t length = 0;
+#ifdef _WIN32
+    string contents;
+#else
+    bool mapped = false;
+#endif
+};
+
+//=============================================================================
+// Compressed Catalog Input
+//=============================================================================
+
+// How a catalog file is stored on disk
+enum class CatalogCompression {
+    None,
+    Gzip,
+    Zstd
+};
+
+/**
+ * Recognize a compressed catalog by its first bytes, whatever its name
+ * @param filename Path to the file
+ * @return The compression format (None if unreadable or plain text)
+ */
+CatalogCompression catalogCompressionOf(const string& filename) {
+    ifstream file(filename, ios::binary);
+    unsigned char magic[4] = {};
+    file.read(reinterpret_cast<char*>(magic), sizeof(magic));
+    if (file.gcount() >= 2 && magic[0] == 0x1F && magic[1] == 0x8B) {
+        return CatalogCompression::Gzip;
+    }
+    if (file.gcount() == 4 && magic[0] == 0x28 && magic[1] == 0xB5 && magic[2] == 0x2F && magic[3] == 0xFD) {
+        return CatalogCompression::Zstd;
+    }
+    return CatalogCompression::None;
+}
+
+/**
+ * Reads a catalog file line by line, like getline on an ifstream, whether
+ * it is plain text or gzip- or zstd-compressed
+ *
+ * A compressed file is decompressed on its own thread into a fixed set of
+ * blocks that circulate between that thread and the reader: filled blocks
+ * go to the reader, and the reader hands each one back once its lines are
+ * parsed. Decompression therefore overlaps parsing, and memory stays at
+ * BLOCK_COUNT blocks however large the file is.
+ */
+class CatalogLineReader {
+public:
+    CatalogLineReader() = default;
+    CatalogLineReader(const CatalogLineReader&) = delete;
+    CatalogLineReader& operator=(const CatalogLineReader&) = delete;
+
+    ~CatalogLineReader() {
+        // A reader that stops early releases the decompressor, which
+        // finishes the block it is on and exits
+        freeBlocks.close();
+        if (decompressor.joinable()) {
+            decompressor.join();
+        }
+    }
+
+    /**
+     * Open a catalog file and, if it is compressed, start decompressing it
+     * @param filename Path to the file
+     * @return False if the file could not be opened
+     */
+    bool open(const string& filename) {
+        compression = catalogCompressionOf(filename);
+        file.open(filename, ios::binary);
+        if (!file.is_open()) {
+            return false;
+        }
+        if (compression == CatalogCompression::None) {
+            return true;
+        }
+#ifndef COURSE_WITH_ZLIB
+        if (compression == CatalogCompression::Gzip) {
+            readError = "gzip-compressed, but this build has no gzip support (rebuild with -DCOURSE_WITH_ZLIB and -lz)";
+            return true;
+        }
+#endif
+#ifndef COURSE_WITH_ZSTD
+        if (compression == CatalogCompression::Zstd) {
+            readError = "zstd-compressed, but this build has no zstd support (rebuild with -DCOURSE_WITH_ZSTD and -lzstd)";
+            return true;
+        }
+#endif
+        for (size_t i = 0; i < BLOCK_COUNT; ++i) {
+            freeBlocks.push(string());
+        }
+        decompressor = thread(&CatalogLineReader::decompress, this);
+        return true;
+    }
+
+    /**
+     * Read the next line, without its newline
+     * @param line Receives the line
+     * @return False at the end of the file or on a read error (see error())
+     */
+    bool getline(string& line) {
+        if (compression == CatalogCompression::None) {
+            return static_cast<bool>(std::getline(file, line));
+        }
+        if (!decompressor.joinable()) {
+            return false;  // No support for this format in the build
+        }
+        line.clear();
+        bool partial = false;
+        while (true) {
+            if (position == current.size()) {
+                if (holdingBlock) {
+                    freeBlocks.push(std::move(current));
+                    holdingBlock = false;
+                }
+                current.clear();
+                position = 0;
+                if (!filledBlocks.pop(current)) {
+                    // The decompressor set readError, if any, before closing the queue
+                    return partial && readError.empty();
+                }
+                holdingBlock = true;
+            }
+            size_t end = current.find('\n', position);
+            if (end == string::npos) {
+                line.append(current, position, string::npos);
+                position = current.size();
+                partial = true;
+                continue;
+            }
+            line.append(current, position, end - position);
+            position = end + 1;
+            return true;
+        }
+    }
+
+    // Why reading stopped early, or empty if the file was read to the end
+    const string& error() const {
+        return readError;
+    }
+
+private:
+    static const size_t BLOCK_COUNT = 4;
+    static const size_t BLOCK_BYTES = 1 << 20;
+    static const size_t INPUT_BYTES = 1 << 17;
+
+    /**
+     * Make sure the block being filled has room, passing a full block on
+     * @return False once the reader has stopped
+     */
+    bool outputSpace() {
+        if (filling && filled < BLOCK_BYTES) {
+            return true;
+        }
+        flushOutput();
+        if (!freeBlocks.pop(output)) {
+            return false;
+        }
+        output.resize(BLOCK_BYTES);
+        filled = 0;
+        filling = true;
+        return true;
+    }
+
+    // Pass the block being filled to the reader, if it holds anything
+    void flushOutput() {
+        if (filling && filled > 0) {
+            output.resize(filled);
+            filledBlocks.push(std::move(output));
+        }
+        filling = false;
+    }
+
+    // Decompressor thread: fill blocks until the input ends or the reader stops
+    void decompress() {
+        vector<char> input(INPUT_BYTES);
+        bool stopped = false;
+#ifdef COURSE_WITH_ZLIB
+        if (compression == CatalogCompression::Gzip) {
+            z_stream stream = {};
+            // 15 + 32: full window, gzip or zlib header detected automatically
+            if (inflateInit2(&stream, 15 + 32) != Z_OK) {
+                readError = "could not start gzip decompression";
+            }
+            bool inputDone = false;
+            bool outputWasFull = false;
+            bool memberOpen = false;
+            while (readError.empty()) {
+                if (stream.avail_in == 0 && !inputDone) {
+                    file.read(input.data(), input.size());
+                    stream.next_in = reinterpret_cast<Bytef*>(input.data());
+                    stream.avail_in = static_cast<uInt>(file.gcount());
+                    inputDone = stream.avail_in == 0;
+                }
+                if (inputDone && !outputWasFull) {
+                    break;
+                }
+                if (!outputSpace()) {
+                    stopped = true;
+                    break;
+                }
+                stream.next_out = reinterpret_cast<Bytef*>(&output[filled]);
+                stream.avail_out = static_cast<uInt>(BLOCK_BYTES - filled);
+                int result = inflate(&stream, Z_NO_FLUSH);
+                filled = BLOCK_BYTES - stream.avail_out;
+                outputWasFull = stream.avail_out == 0;
+                if (result == Z_STREAM_END) {
+                    // Concatenated files hold several gzip members
+                    memberOpen = false;
+                    inflateReset(&stream);
+                } else if (result == Z_OK || result == Z_BUF_ERROR) {
+                    memberOpen = true;
+                } else {
+                    readError = "corrupt gzip data";
+                }
+            }
+            if (memberOpen && !stopped && readError.empty()) {
+                readError = "truncated gzip data";
+            }
+            inflateEnd(&stream);
+        }
+#endif
+#ifdef COURSE_WITH_ZSTD
+        if (compression == CatalogCompression::Zstd) {
+            ZSTD_DCtx* context = ZSTD_createDCtx();
+            ZSTD_inBuffer in = {input.data(), 0, 0};
+            bool inputDone = false;
+            bool outputWasFull = false;
+            size_t frameRemaining = 0;  // Nonzero while a frame is incomplete
+            while (context != nullptr && readError.empty()) {
+                if (in.pos == in.size && !inputDone) {
+                    file.read(input.data(), input.size());
+                    in.size = static_cast<size_t>(file.gcount());
+                    in.pos = 0;
+                    inputDone = in.size == 0;
+                }
+                if (inputDone && !outputWasFull) {
+                    break;
+                }
+                if (!outputSpace()) {
+                    stopped = true;
+                    break;
+                }
+                ZSTD_outBuffer out = {&output[0], BLOCK_BYTES, filled};
+                size_t result = ZSTD_decompressStream(context, &out, &in);
+                if (ZSTD_isError(result)) {
+                    readError = string("corrupt zstd data (") + ZSTD_getErrorName(result) + ")";
+                    break;
+                }
+                filled = out.pos;
+                outputWasFull = out.pos == out.size;
+                frameRemaining = result;
+            }
+            if (context == nullptr) {
+                readError = "could not start zstd decompression";
+            } else if (frameRemaining != 0 && !stopped && readError.empty()) {
+                readError = "truncated zstd data";
+            }
+            ZSTD_freeDCtx(context);
+        }
+#endif
+        if (!stopped && readError.empty()) {
+            flushOutput();
+        }
+        filledBlocks.close();
+    }
+
+    ifstream file;
+    CatalogCompression compression = CatalogCompression::None;
+    string readError;
+
+    // Decompressor side
+    thread decompressor;
+    string output;       // Block being filled
+    size_t filled = 0;
+    bool filling = false;
+
+    // Reader side
+    BoundedQueue<string> filledBlocks{BLOCK_COUNT};
+    BoundedQueue<string> freeBlocks{BLOCK_COUNT};
+    string current;      // Block being split into lines
+    size_t position = 0;
+    bool holdingBlock = false;
+};
+
+//=============================================================================
+// Hash Table Class Definition
+//=============================================================================
+
+// Shape and memory use of a hash table, from HashTable::stats()
+struct HashTableStats {
+    size_t courseCount = 0;
+    unsigned int bucketCount = 0;
+    size_t usedBuckets = 0;        // Buckets holding at least one course
+    size_t collisions = 0;         // Courses stored behind another course in their bucket
+    size_t longestChain = 0;
+    vector<size_t> chainLengths;   // [k] = buckets holding k courses; the last entry is "k or more"
+    size_t nodeBytes = 0;          // Nodes, including each Course's inline string and vector headers
+    size_t bucketBytes = 0;        // The bucket pointer array
+    size_t stringBytes = 0;        // Heap buffers of course numbers and titles
+    size_t prerequisiteBytes = 0;  // Prerequisite vector buffers and their strings' heap buffers
+    size_t heapBlocks = 0;         // Allocations owned by the nodes and their courses
+    size_t columnBytes = 0;        // Columnar copy, 0 if not built
+    size_t mappedBytes = 0;        // Catalog files that lazily loaded titles point into
+    size_t departmentBytes = 0;    // Department index, if built
+    size_t departmentCount = 0;
+};
+
+// Hash table implementation for storing courses
+// Uses chaining for collision resolution
+
+class HashTable {
+private:
+    // Structure for nodes in the chain
+    struct Node {
+        Course course;
+        Node* next;
+        uint32_t row = NO_ROW; // Row in the columnar store, if it is current
+
+        // Construct the course in place from any Course constructor's arguments
+        template <typename... Args>
+        explicit Node(Args&&... args) : course(std::forward<Args>(args)...), next(nullptr) {}
+    };
+
+    static const uint32_t NO_ROW = numeric_limits<uint32_t>::max();
+
+    vector<Node*> table; // Hash table buckets
+    unsigned int tableSize; // Size of the hash table
+    size_t courseCount = 0; // Number of courses stored
+    FrozenCourseIndex frozen; // Read-only index, dropped on the first change
+    CourseBloomFilter filter; // Screens out lookups of course numbers that are not stored
+    size_t removedSinceFilterBuild = 0; // Removed keys still set in the filter
+    bool filterEnabled = true;
+    mutable LookupFilterStats filterStats;
+    CourseDetailCache detailCache; // Rendered course details, dropped per course on change
+    CourseColumns columnStore; // Columnar copy for scans, built on first use
+    bool columnsBuilt = false;
+    EligibilityMatrix eligibilityStore; // Prerequisite bit matrix over columnStore's rows
+    bool eligibilityBuilt = false; // Dropped whenever a column row changes
+    vector<string> staleRows; // Courses handed out by search() since the last scan
+    DepartmentIndex departmentStore; // Ordered per-department index, built on first use
+    bool departmentsBuilt = false;
+    PrerequisiteChains chainStore; // Chain depths and heights, built on first use
+    bool chainsBuilt = false;
+    vector<string> chainChanges; // Courses added, removed or handed out by search() since then
+    vector<shared_ptr<const MappedCatalogFile>> titleSources; // Files that lazily loaded titles point into
+
+    /**
+     * Give a node's current contents a fresh row, retiring the old one
+     * @param node The node to copy into the columnar store
+     */
+    void appendColumnRow(Node* node) {
+        if (node->row != NO_ROW) {
+            columnStore.retireRow(node->row);
+        }
+        node->row = columnStore.appendRow(node->course);
+        eligibilityBuilt = false;
+    }
+
+    // Build the columnar store from scratch, dropping dead rows
+    void rebuildColumns() {
+        columnStore.clear();
+        columnStore.reserve(courseCount);
+        for (Node* head : table) {
+            for (Node* node = head; node != nullptr; node = node->next) {
+                node->row = columnStore.appendRow(node->course);
+            }
+        }
+        staleRows.clear();
+        columnsBuilt = true;
+        eligibilityBuilt = false;
+    }
+
+    /**
+     * Find the node holding a course
+     * @param courseNumber The course number to search for
+     * @return The node, or nullptr if not found
+     */
+    Node* findNode(const string& courseNumber) const {
+        for (Node* current = table[hash(courseNumber)]; current != nullptr; current = current->next) {
+            if (current->course.courseNumber == courseNumber) {
+                return current;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Refill the lookup filter from the stored courses
+     * @param expectedCourses Number of courses to size the filter for
+     */
+    void rebuildFilter(size_t expectedCourses) {
+        filter.rebuild(expectedCourses);
+        forEachCourse([this](const Course& course) { filter.add(courseKeyHash(course.courseNumber)); });
+        removedSinceFilterBuild = 0;
+    }
+
+    /**
+     * Ask the lookup filter about a key and count a definite miss
+     * @param keyHash courseKeyHash() of the course number
+     * @return False if the course is certainly not stored
+     */
+    bool passesFilter(uint64_t keyHash) const {
+        if (!filterEnabled || filter.mayContain(keyHash)) {
+            return true;
+        }
+        ++filterStats.rejected;
+        return false;
+    }
+
+    // Count the outcome of a lookup that got past the filter
+    void countFilterPass(bool found) const {
+        if (filterEnabled) {
+            ++(found ? filterStats.passedFound : filterStats.falsePositives);
+        }
+    }
+
+    /**
+     * This hash function determines the bucket index
+     * @param key The course number to hash
+     * @return The bucket index
+     */
+    unsigned int hash(const string& key) const {
+        return bucketOf(courseKeyHash(key));
+    }
+
+    // Bucket for an already computed key hash, so the filter and the
+    // chains share one pass over the key
+    unsigned int bucketOf(uint64_t keyHash) const {
+        return static_cast<unsigned int>(keyHash % tableSize);
+    }
+
+    /**
+     * Find the smallest prime at or above a value, for bucket counts
+     * @param value The lower bound
+     * @return The prime
+     */
+    static unsigned int nextPrime(unsigned int value) {
+        for (unsigned int candidate = max(value, 2u); ; ++candidate) {
+            bool prime = true;
+            for (unsigned int divisor = 2; divisor * divisor <= candidate; ++divisor) {
+                if (candidate % divisor == 0) {
+                    prime = false;
+                    break;
+                }
+            }
+            if (prime) {
+                return candidate;
+            }
+        }
+    }
+
+public:
+    /**
+     * Constructor to initialize the hash table with a specified size
+     * @param size The size of the hash table (default 179 - prime number)
+     */
+    HashTable(unsigned int size = 179) {
+        tableSize = size;
+        table.resize(tableSize, nullptr);
+    }
+
+    /**
+     * Destructor to clean up memory used by the hash table
+     */
+    ~HashTable() {
+        for (unsigned int i=0; i < tableSize; ++i) {
+            Node* current = table[i];
+            while (current != nullptr) {
+                Node* temp = current;
+                current = current->next;
+                delete temp;
+            }
+        }
+    }
+
+    /**
+     * Inserts a copy of a course into the hash table
+     * @param course The course to insert
+     */
+    void insert(const Course& course) {
+        emplace(course);
+    }
+
+    /**
+     * Inserts a course into the hash table, taking over its strings
+     * @param course The course to insert (left empty)
+     */
+    void insert(Course&& course) {
+        emplace(std::move(course));
+    }
+
+    /**
+     * Construct a course directly in a new node
+     * @param args Arguments for a Course constructor: a Course to copy or
+     *        move from, or the number, title and prerequisites
+     * @return The stored course
+     */
+    template <typename... Args>
+    const Course& emplace(Args&&... args) {
+        // Create a new node
+        Node* newNode = new Node(std::forward<Args>(args)...);
+        const string& courseNumber = newNode->course.courseNumber;
+
+        thaw();
+        uint64_t keyHash = courseKeyHash(courseNumber);
+        unsigned int index = bucketOf(keyHash);
+        detailCache.invalidate(courseNumber);
+
+        // If bucket is empty, insert at head
+        if (table[index] == nullptr) {
+            table[index] = newNode;
+        } else {
+            // Chain at the beginning for efficiency
+            newNode->next = table[index];
+            table[index] = newNode;
+        }
+        ++courseCount;
+        if (columnsBuilt) {
+            appendColumnRow(newNode);
+        }
+        if (departmentsBuilt) {
+            departmentStore.add(newNode->course);
+        }
+        if (chainsBuilt) {
+            chainChanges.push_back(courseNumber);
+        }
+
+        // Doubling the filter when it fills keeps the rebuilds amortized O(1)
+        if (courseCount > filter.capacity()) {
+            rebuildFilter(max<size_t>(64, courseCount * 2));
+        } else {
+            filter.add(keyHash);
+        }
+        return newNode->course;
+    }
+
+    /**
+     * Grow the bucket array so that the given number of courses fits at a
+     * load factor of at most 0.75. Existing nodes are relinked, not copied.
+     * @param expectedCourses The number of courses the table should hold
+     */
+    void reserve(size_t expectedCourses) {
+        if (expectedCourses > filter.capacity()) {
+            rebuildFilter(expectedCourses);
+        }
+        size_t wanted = expectedCourses + expectedCourses / 3;
+        if (wanted <= tableSize || wanted > numeric_limits<unsigned int>::max() / 2) {
+            return;
+        }
+
+        vector<Node*> oldTable;
+        oldTable.swap(table);
+        tableSize = nextPrime(static_cast<unsigned int>(wanted));
+        table.assign(tableSize, nullptr);
+
+        for (Node* head : oldTable) {
+            while (head != nullptr) {
+                Node* node = head;
+                head = head->next;
+                unsigned int index = hash(node->course.courseNumber);
+                node->next = table[index];
+                table[index] = node;
+            }
+        }
+    }
+
+    /**
+     * Insert a whole batch of validated courses, sizing the table once up front
+     * @param courses The courses to insert
+     */
+    void insertAll(const vector<Course>& courses) {
+        reserve(courseCount + courses.size());
+        for (const auto& course : courses) {
+            insert(course);
+        }
+    }
+
+    /**
+     * Insert a whole batch of validated courses, moving each one into its node
+     * @param courses The courses to insert (left empty)
+     */
+    void insertAll(vector<Course>&& courses) {
+        reserve(courseCount + courses.size());
+        for (auto& course : courses) {
+            insert(std::move(course));
+        }
+        courses.clear();
+    }
+
+    /**
+     * Insert a batch of courses from several threads at once
+     * The table is sized once, then each worker pushes its share of nodes
+     * onto the bucket chains with a compare-and-swap on the chain head, so
+     * no worker ever waits on a lock. A worker whose swap loses a race
+     * checks only the nodes that were pushed in between before retrying,
+     * which keeps duplicate detection exact: of two courses with the same
+     * number, the first one published stays and the other is dropped.
+     * @param courses The courses to insert (left empty)
+     * @param threadCount Number of inserting threads, including the caller
+     * @return Number of courses dropped as duplicates
+     */
+    size_t insertAllConcurrent(vector<Course>&& courses, unsigned int threadCount) {
+        thaw();
+        reserve(courseCount + courses.size());
+        threadCount = static_cast<unsigned int>(max<size_t>(1, min<size_t>(threadCount, courses.size() / 1024)));
+
+        // Atomic copies of the bucket heads for the duration of the build
+        vector<atomic<Node*>> heads(tableSize);
+        for (unsigned int i = 0; i < tableSize; ++i) {
+            heads[i].store(table[i], memory_order_relaxed);
+        }
+
+        vector<vector<uint64_t>> insertedHashes(threadCount);
+        vector<size_t> duplicates(threadCount, 0);
+        auto insertRange = [&](unsigned int worker) {
+            size_t first = courses.size() * worker / threadCount;
+            size_t last = courses.size() * (worker + 1) / threadCount;
+            insertedHashes[worker].reserve(last - first);
+            for (size_t i = first; i < last; ++i) {
+                uint64_t keyHash = courseKeyHash(courses[i].courseNumber);
+                atomic<Node*>& head = heads[bucketOf(keyHash)];
+                Node* newNode = new Node(std::move(courses[i]));
+                const string& courseNumber = newNode->course.courseNumber;
+
+                Node* seen = head.load(memory_order_acquire);
+                Node* checkedFrom = nullptr; // Nodes from here down were already compared
+                while (true) {
+                    bool duplicate = false;
+                    for (Node* current = seen; current != checkedFrom; current = current->next) {
+                        if (current->course.courseNumber == courseNumber) {
+                            duplicate = true;
+                            break;
+                        }
+                    }
+                    if (duplicate) {
+                        delete newNode;
+                        ++duplicates[worker];
+                        break;
+                    }
+                    newNode->next = seen;
+                    checkedFrom = seen;
+                    // On failure seen is reloaded with the current head
+                    if (head.compare_exchange_weak(seen, newNode, memory_order_release, memory_order_acquire)) {
+                        insertedHashes[worker].push_back(keyHash);
+                        break;
+                    }
+                }
+            }
+        };
+
+        vector<thread> workers;
+        for (unsigned int worker = 1; worker < threadCount; ++worker) {
+            workers.emplace_back(insertRange, worker);
+        }
+        insertRange(0);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        // The joins order every push before these plain reads
+        for (unsigned int i = 0; i < tableSize; ++i) {
+            table[i] = heads[i].load(memory_order_relaxed);
+        }
+        size_t dropped = 0;
+        for (unsigned int worker = 0; worker < threadCount; ++worker) {
+            for (uint64_t keyHash : insertedHashes[worker]) {
+                filter.add(keyHash);
+            }
+            courseCount += insertedHashes[worker].size();
+            dropped += duplicates[worker];
+        }
+        // New courses were not stored before, so no cached details refer to
+        // them; the columnar copy and department index are rebuilt on their next use
+        columnsBuilt = false;
+        departmentsBuilt = false;
+        chainsBuilt = false;
+        courses.clear();
+        return dropped;
+    }
+
+    /**
+     * Get the number of courses stored
+     * @return The course count
+     */
+    size_t size() const {
+        return courseCount;
+    }
+
+    /**
+     * Search for a course by its course number for modification
+     * Changing the course would make a frozen index and its cached
+     * details stale, so both are dropped
+     * @param courseNumber The course number to search for
+     * @return Pointer to the course if found, nullptr otherwise
+     */
+    Course* search(const string& courseNumber) {
+        thaw();
+        detailCache.invalidate(courseNumber);
+        uint64_t keyHash = courseKeyHash(courseNumber);
+        if (!passesFilter(keyHash)) {
+            return nullptr;
+        }
+        unsigned int index = bucketOf(keyHash);
+        Node* current = table[index];
+
+        // Traverse the chain at this bucket
+        while (current != nullptr) {
+            if (current->course.courseNumber == courseNumber) {
+                countFilterPass(true);
+                // The caller may change it, so its row is refreshed before the next scan
+                if (columnsBuilt) {
+                    staleRows.push_back(courseNumber);
+                }
+                if (chainsBuilt) {
+                    chainChanges.push_back(courseNumber);
+                }
+                return &(current->course);
+            }
+            current = current->next;
+        }
+
+        countFilterPass(false);
+        return nullptr; // Course not found
+    }
+
+
+    /**
+     * Get all courses in the hash table
+     * @return A vector of all courses
+     */
+    vector<Course> getAllCourses() {
+        vector<Course> allCourses;
+
+        // Iterate through all buckets
+        for (unsigned int i = 0; i < tableSize; ++i) {
+            Node* current = table[i];
+
+            // Traverse the chain and collect all courses
+            while (current != nullptr) {
+                allCourses.push_back(current->course);
+                current = current->next;
+            }
+        }
+
+        return allCourses;
+    }
+
+    /**
+     * Get the number of buckets, for callers that walk the table in slices
+     * @return The bucket count
+     */
+    unsigned int bucketCount() const {
+        return tableSize;
+    }
+
+    /**
+     * Visit the courses stored in a range of buckets without copying them
+     * @param visit Callback invoked with a const reference to each course
+     * @param firstBucket First bucket to visit
+     * @param lastBucket One past the last bucket to visit (clamped to the table size)
+     */
+    template <typename Visitor>
+    void forEachCourse(Visitor visit, unsigned int firstBucket = 0, unsigned int lastBucket = numeric_limits<unsigned int>::max()) const {
+        lastBucket = min(lastBucket, tableSize);
+        for (unsigned int i = firstBucket; i < lastBucket; ++i) {
+            for (const Node* current = table[i]; current != nullptr; current = current->next) {
+                visit(current->course);
+            }
+        }
+    }
+/**
+ * Remove a course from the hash table
+ * @param courseNumber The course number to remove
+ * @return True if the course was removed, false if not found
+ */
+bool remove(const string& courseNumber) {
+    thaw();
+    detailCache.invalidate(courseNumber);
+    unsigned int index = hash(courseNumber);
+    Node* current = table[index];
+    Node* prev = nullptr;
+
+    // Traverse the chain at this bucket
+    while (current != nullptr) {
+        if (current->course.courseNumber == courseNumber) {
+            // Course found, remove it
+            if (prev == nullptr) {
+                // Removing head of the chain
+                table[index] = current->next;
+            } else {
+                // Removing from middle or end of the chain
+                prev->next = current->next;
+            }
+            if (columnsBuilt && current->row != NO_ROW) {
+                columnStore.retireRow(current->row);
+                eligibilityBuilt = false;
+            }
+            if (departmentsBuilt) {
+                departmentStore.remove(current->course);
+            }
+            if (chainsBuilt) {
+                chainChanges.push_back(courseNumber);
+            }
+            delete current;
+            --courseCount;
+
+            // A stale filter only lets more misses through, so rebuild it
+            // once removed keys make up a quarter of what it holds
+            if (++removedSinceFilterBuild > courseCount / 4) {
+                rebuildFilter(max(filter.capacity() / 2, courseCount));
+            }
+            return true; // Course removed
+        }
+        prev = current;
+        current = current->next;
+    }
+
+    return false; // Course not found
+
+
+}
+
+    /**
+     * Exchange the contents of two hash tables without copying any nodes
+     * @param other The hash table to swap with
+     */
+    void swap(HashTable& other) {
+        table.swap(other.table);
+        std::swap(tableSize, other.tableSize);
+        std::swap(courseCount, other.courseCount);
+        std::swap(frozen, other.frozen);
+        filter.swap(other.filter);
+        std::swap(removedSinceFilterBuild, other.removedSinceFilterBuild);
+        detailCache.swap(other.detailCache);
+        columnStore.swap(other.columnStore);
+        std::swap(columnsBuilt, other.columnsBuilt);
+        std::swap(eligibilityStore, other.eligibilityStore);
+        std::swap(eligibilityBuilt, other.eligibilityBuilt);
+        staleRows.swap(other.staleRows);
+        departmentStore.swap(other.departmentStore);
+        std::swap(departmentsBuilt, other.departmentsBuilt);
+        chainStore.swap(other.chainStore);
+        std::swap(chainsBuilt, other.chainsBuilt);
+        chainChanges.swap(other.chainChanges);
+        titleSources.swap(other.titleSources);
+    }
+
+    /**
+     * Keep a mapped file alive for as long as the table, because courses
+     * inserted from it have titles that point into it
+     * @param source The mapped catalog file
+     */
+    void keepTitleSource(shared_ptr<const MappedCatalogFile> source) {
+        titleSources.push_back(std::move(source));
+    }
+
+    /**
+     * Look up a course for reading; uses the frozen index when there is one
+     * @param courseNumber The course number to search for
+     * @return Pointer to the course if found, nullptr otherwise
+     */
+    const Course* find(const string& courseNumber) const {
+        uint64_t keyHash = courseKeyHash(courseNumber);
+        if (!passesFilter(keyHash)) {
+            return nullptr;
+        }
+        const Course* course = nullptr;
+        if (!frozen.empty()) {
+            course = frozen.find(courseNumber, keyHash);
+        } else {
+            for (const Node* current = table[bucketOf(keyHash)]; current != nullptr; current = current->next) {
+                if (current->course.courseNumber == courseNumber) {
+                    course = &current->course;
+                    break;
+                }
+            }
+        }
+        countFilterPass(course != nullptr);
+        return course;
+    }
+
+    /**
+     * Build a minimal perfect hash index for read-mostly use; find() then
+     * takes one probe. Any insert, remove or search() for modification
+     * drops the index and lookups fall back to the chains. The department
+     * index is brought up to date at the same time.
+     * @param threadCount Number of threads to build the indexes on
+     * @return True if the index was built
+     */
+    bool freeze(unsigned int threadCount) {
+        vector<const Course*> courses;
+        courses.reserve(courseCount);
+        forEachCourse([&courses](const Course& course) { courses.push_back(&course); });
+        if (courses.empty() || !frozen.build(courses, threadCount)) {
+            return false;
+        }
+        // No more inserts are expected, so size the filter exactly
+        rebuildFilter(courseCount);
+        if (departmentsBuilt) {
+            departmentStore.prepare(threadCount);
+        } else {
+            departmentStore.build(courses, threadCount);
+            departmentsBuilt = true;
+        }
+        return true;
+    }
+
+    bool isFrozen() const {
+        return !frozen.empty();
+    }
+
+    const FrozenCourseIndex& frozenIndex() const {
+        return frozen;
+    }
+
+    /**
+     * Measure the bucket chains and the memory held by the stored courses
+     * String buffers short enough for the library's inline storage cost no
+     * heap memory and are not counted as separate blocks
+     * @param histogramBuckets Number of chain-length histogram entries
+     * @return The statistics
+     */
+    HashTableStats stats(size_t histogramBuckets = 8) const {
+        const size_t inlineCapacity = string().capacity();
+        auto heapBytes = [inlineCapacity](const string& text) -> size_t {
+            return text.capacity() > inlineCapacity ? text.capacity() + 1 : 0;
+        };
+
+        HashTableStats result;
+        result.courseCount = courseCount;
+        result.bucketCount = tableSize;
+        result.chainLengths.assign(max<size_t>(2, histogramBuckets), 0);
+        result.bucketBytes = table.capacity() * sizeof(Node*);
+        for (const Node* head : table) {
+            size_t length = 0;
+            for (const Node* node = head; node != nullptr; node = node->next) {
+                ++length;
+                const Course& course = node->course;
+                result.nodeBytes += sizeof(Node);
+                ++result.heapBlocks;
+                for (const string* text : {&course.courseNumber, &course.courseTitle}) {
+                    size_t bytes = heapBytes(*text);
+                    result.stringBytes += bytes;
+                    result.heapBlocks += bytes != 0;
+                }
+                if (course.prerequisites.capacity() != 0) {
+                    result.prerequisiteBytes += course.prerequisites.capacity() * sizeof(string);
+                    ++result.heapBlocks;
+                }
+                for (const auto& prereq : course.prerequisites) {
+                    size_t bytes = heapBytes(prereq);
+                    result.prerequisiteBytes += bytes;
+                    result.heapBlocks += bytes != 0;
+                }
+            }
+            result.usedBuckets += length != 0;
+            result.collisions += length > 1 ? length - 1 : 0;
+            result.longestChain = max(result.longestChain, length);
+            ++result.chainLengths[min(length, result.chainLengths.size() - 1)];
+        }
+        result.columnBytes = columnsBuilt ? columnStore.bytes() : 0;
+        if (departmentsBuilt) {
+            result.departmentBytes = departmentStore.bytes();
+            result.departmentCount = departmentStore.departments().size();
+        }
+        for (const auto& source : titleSources) {
+            result.mappedBytes += source->size();
+        }
+        return result;
+    }
+
+    // Drop the frozen index; lookups go back to the chains
+    void thaw() {
+        if (!frozen.empty()) {
+            frozen.clear();
+        }
+    }
+
+    /**
+     * Turn the lookup filter on or off (it is still maintained while off)
+     * @param enabled Whether find() and search() consult the filter
+     */
+    void setLookupFilterEnabled(bool enabled) {
+        filterEnabled = enabled;
+    }
+
+    const CourseBloomFilter& lookupFilter() const {
+        return filter;
+    }
+
+    LookupFilterStats lookupFilterStats() const {
+        return filterStats;
+    }
+
+    void resetLookupFilterStats() {
+        filterStats = LookupFilterStats();
+    }
+
+    /**
+     * Rendered course details; entries are dropped here whenever their
+     * course changes, so callers only need get() and put()
+     */
+    CourseDetailCache& renderedDetails() {
+        return detailCache;
+    }
+
+    const CourseDetailCache& renderedDetails() const {
+        return detailCache;
+    }
+
+    /**
+     * Columnar copy of the catalog for scans that need only some fields.
+     * Built on first use and then kept current: inserts append a row,
+     * removals retire one, and courses handed out by search() get a fresh
+     * row here. Row ids and views stay valid until the table next changes.
+     * @return The columnar store
+     */
+    const CourseColumns& columns() {
+        if (!columnsBuilt) {
+            rebuildColumns();
+            return columnStore;
+        }
+        for (const auto& courseNumber : staleRows) {
+            Node* node = findNode(courseNumber);
+            if (node != nullptr) {
+                appendColumnRow(node);
+            }
+        }
+        staleRows.clear();
+        // Rebuild once dead rows outnumber live ones
+        if (columnStore.rowCount() > 2 * columnStore.liveRowCount() + 1024) {
+            rebuildColumns();
+        }
+        return columnStore;
+    }
+
+    /**
+     * Prerequisite bit matrix over columns() for eligibility queries.
+     * Built on first use and kept until a column row changes; it refers
+     * to the rows of the columns() result of the same call.
+     * @return The eligibility matrix
+     */
+    const EligibilityMatrix& eligibility() {
+        const CourseColumns& current = columns();
+        if (!eligibilityBuilt) {
+            eligibilityStore.build(current);
+            eligibilityBuilt = true;
+        }
+        return eligibilityStore;
+    }
+
+    /**
+     * Courses by department, ordered by level, for department listings and
+     * level ranges. Built on first use and then kept current by inserts and
+     * removals; departments changed since the last call are re-sorted here.
+     * Results stay valid until the table next changes.
+     * @param threadCount Number of threads to build or sort departments on
+     * @return The department index
+     */
+    const DepartmentIndex& departments(unsigned int threadCount) {
+        if (!departmentsBuilt) {
+            vector<const Course*> courses;
+            courses.reserve(courseCount);
+            forEachCourse([&courses](const Course& course) { courses.push_back(&course); });
+            departmentStore.build(courses, threadCount);
+            departmentsBuilt = true;
+        } else {
+            departmentStore.prepare(threadCount);
+        }
+        return departmentStore;
+    }
+
+    /**
+     * Longest prerequisite chains: each course's depth, height and
+     * critical-path membership. Built on first use; after that, courses
+     * added, removed or handed out by search() are applied incrementally
+     * here, unless so many changed that a rebuild is cheaper.
+     * @param threadCount Number of threads to build on
+     * @return The chains, valid until the table next changes
+     */
+    const PrerequisiteChains& prerequisiteChains(unsigned int threadCount) {
+        if (!chainsBuilt || chainChanges.size() > courseCount / 4) {
+            vector<const Course*> courses;
+            courses.reserve(courseCount);
+            forEachCourse([&courses](const Course& course) { courses.push_back(&course); });
+            chainStore.build(courses, threadCount);
+            chainsBuilt = true;
+        } else {
+            for (const auto& courseNumber : chainChanges) {
+                Node* node = findNode(courseNumber);
+                chainStore.update(courseNumber, node != nullptr ? &node->course : nullptr);
+            }
+            chainStore.applyUpdates(threadCount);
+        }
+        chainChanges.clear();
+        return chainStore;
+    }
+};
+
+//=============================================================================
+// Operation Journal
+//=============================================================================
+
+/**
+ * Force a file's written data to disk
+ * @param file An open file whose stdio buffer is already flushed
+ * @return True if the data is durable
+ */
+bool syncFile(FILE* file) {
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+/**
+ * Make a rename or create in a file's directory durable (POSIX only;
+ * Windows cannot open a directory for flushing)
+ * @param path Path of a file in the directory
+ * @return True if the directory entry is durable
+ */
+bool syncParentDirectory(const string& path) {
+#ifdef _WIN32
+    (void)path;
+    return true;
+#else
+    string directory = filesystem::path(path).parent_path().string();
+    int fd = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    bool synced = fsync(fd) == 0;
+    ::close(fd);
+    return synced;
+#endif
+}
+
+/**
+ * Append-only write-ahead journal of catalog changes
+ *
+ * Every add, remove, edit and prerequisite cleanup is appended as a compact
+ * binary record, so persisting a change costs one small append instead of
+ * rewriting the catalog. Loading the base file(s) again replays the
+ * journal; an export over the base file is a snapshot and starts a new,
+ * empty journal. Undo appends inverse records, so replay reproduces it.
+ *
+ * File layout: "ABCUJRN1", u32 length + base description, then records:
+ *   u32 bodyLength | body | u32 checksum (FNV-1a of body)
+ *   body = u8 type, u8 flags, u32 operationId, payload
+ * A torn or corrupt record at the end (crash mid-append) is discarded.
+ *
+ * Records are buffered and written with a single write + fsync per group
+ * commit: after each menu operation, after each round of the server's
+ * executor, or once JOURNAL_GROUP_COMMIT_BYTES of records are waiting.
+ */
+class CourseJournal {
+public:
+    enum RecordType : uint8_t {
+        AddCourse = 1,           // payload: course
+        RemoveCourse = 2,        // payload: full course, so undo can re-add it
+        StripPrerequisite = 3,   // payload: removed number, (course, index) pairs
+        RestorePrerequisite = 4, // payload: same as StripPrerequisite
+        UpdateCourse = 5         // payload: course after, course before the edit
+    };
+
+    // Set on records appended by undo; operationId names the undone operation
+    static const uint8_t UNDO_FLAG = 1;
+
+    struct Record {
+        RecordType type = AddCourse;
+        uint8_t flags = 0;
+        uint32_t operationId = 0;
+        Course course;                                  // AddCourse / RemoveCourse / UpdateCourse
+        Course previous;                                // UpdateCourse
+        string prerequisite;                            // Strip / Restore
+        vector<pair<string, uint32_t>> positions;       // Strip / Restore, ascending index per course
+    };
+
+    ~CourseJournal() {
+        close();
+    }
+
+    /**
+     * Open (or create) the journal for a set of loaded files and replay it
+     * @param path Journal file path
+     * @param baseDescription Identifies the loaded base files
+     * @param snapshotTarget The single base file a snapshot export may overwrite ("" if several)
+     * @param hashTable The freshly loaded catalog to replay onto
+     * @param out Stream for replay and recovery messages
+     * @return True if journaling is active
+     */
+    bool open(const string& path, const string& baseDescription, const string& snapshotTarget, HashTable& hashTable, ostream& out) {
+        close();
+        snapshotFile.clear();
+        undoStack.clear();
+        nextOperationId = 1;
+
+        ifstream existing(path, ios::binary);
+        if (existing.is_open()) {
+            string contents((istreambuf_iterator<char>(existing)), istreambuf_iterator<char>());
+            existing.close();
+            if (!replay(path, contents, baseDescription, hashTable, out)) {
+                return false;
+            }
+        } else if (!writeHeader(path, baseDescription)) {
+            out << "Warning: Could not create journal '" << path << "'; changes will not be saved." << endl;
+            return false;
+        }
+
+        file = fopen(path.c_str(), "ab");
+        if (file == nullptr) {
+            out << "Warning: Could not open journal '" << path << "'; changes will not be saved." << endl;
+            return false;
+        }
+        journalPath = path;
+        base = baseDescription;
+        snapshotFile = snapshotTarget;
+        return true;
+    }
+
+    // Commit outstanding records and close the journal file
+    void close() {
+        commit();
+        if (file != nullptr) {
+            fclose(file);
+            file = nullptr;
+        }
+    }
+
+    bool isOpen() const {
+        return file != nullptr;
+    }
+
+    const string& path() const {
+        return journalPath;
+    }
+
+    // Start a new user-level operation; the records that follow undo together
+    void beginOperation() {
+        currentOperationId = nextOperationId++;
+    }
+
+    void recordAdd(const Course& course) {
+        Record record;
+        record.type = AddCourse;
+        record.course = course;
+        record.course.materializeTitle();
+        append(record);
+    }
+
+    void recordRemove(const Course& course) {
+        Record record;
+        record.type = RemoveCourse;
+        record.course = course;
+        record.course.materializeTitle();
+        append(record);
+    }
+
+    void recordUpdate(const Course& before, const Course& after) {
+        Record record;
+        record.type = UpdateCourse;
+        record.course = after;
+        record.previous = before;
+        record.course.materializeTitle();
+        record.previous.materializeTitle();
+        append(record);
+    }
+
+    void recordStrip(const string& prerequisite, const vector<pair<string, uint32_t>>& positions) {
+        Record record;
+        record.type = StripPrerequisite;
+        record.prerequisite = prerequisite;
+        record.positions = positions;
+        append(record);
+    }
+
+    /**
+     * Write buffered records and fsync them (one group commit)
+     * A failed write stops journaling: the file no longer matches the
+     * catalog, so it is closed and the undo history is dropped
+     * @return False if records were lost since the last commit
+     */
+    bool commit() {
+        if (file != nullptr && !pending.empty()) {
+            bool ok = fwrite(pending.data(), 1, pending.size(), file) == pending.size() && fflush(file) == 0 && syncFile(file);
+            pending.clear();
+            if (!ok) {
+                fclose(file);
+                file = nullptr;
+                undoStack.clear();
+                writeFailed = true;
+            }
+        }
+        bool ok = !writeFailed;
+        writeFailed = false;
+        return ok;
+    }
+
+    /**
+     * Explain a failed commit
+     * @param out Stream for the message
+     */
+    void reportFailure(ostream& out) const {
+        out << "Warning: Could not write journal '" << journalPath << "'; the last change was not saved and "
+            << "journaling has stopped. Export the catalog to keep your changes." << endl;
+    }
+
+    // Count of records appended so far; tells a caller whether an operation was journaled
+    uint64_t recordsAppended() const {
+        return appendedRecords;
+    }
+
+    /**
+     * Revert the most recent operation that has not been undone yet
+     * @param hashTable Reference to the hash table containing courses
+     * @param out Stream for status messages
+     * @return True if an operation was undone
+     */
+    bool undoLast(HashTable& hashTable, ostream& out) {
+        if (undoStack.empty()) {
+            out << "Nothing to undo." << endl;
+            return false;
+        }
+
+        vector<Record> group = move(undoStack.back());
+        undoStack.pop_back();
+
+        // Apply inverse records newest first. If one no longer matches, the
+        // ones already applied are rolled back and the operation stays undoable.
+        vector<Record> inverses;
+        inverses.reserve(group.size());
+        for (auto it = group.rbegin(); it != group.rend(); ++it) {
+            Record inverse = *it;
+            inverse.flags = UNDO_FLAG;
+            switch (it->type) {
+                case AddCourse: inverse.type = RemoveCourse; break;
+                case RemoveCourse: inverse.type = AddCourse; break;
+                case StripPrerequisite: inverse.type = RestorePrerequisite; break;
+                case RestorePrerequisite: inverse.type = StripPrerequisite; break;
+                case UpdateCourse: swap(inverse.course, inverse.previous); break;
+            }
+            if (!applyRecord(hashTable, inverse)) {
+                for (auto undone = it.base(); undone != group.end(); ++undone) {
+                    applyRecord(hashTable, *undone);
+                }
+                out << "Error: Could not undo change to '" << describe(*it) << "'; the catalog no longer matches. Nothing was undone." << endl;
+                undoStack.push_back(move(group));
+                return false;
+            }
+            inverses.push_back(move(inverse));
+        }
+
+        size_t reported = 0;
+        for (const Record& inverse : inverses) {
+            appendEncoded(inverse);
+            // A bulk add is one operation; list only its first few courses
+            if (++reported <= UNDO_REPORT_LIMIT) {
+                out << "Undone: " << describeChange(group[group.size() - reported]) << endl;
+            }
+        }
+        if (reported > UNDO_REPORT_LIMIT) {
+            out << "... and " << (reported - UNDO_REPORT_LIMIT) << " more changes undone." << endl;
+        }
+        if (!commit()) {
+            reportFailure(out);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Called after a successful export; saving over the base file is a
+     * snapshot, so the journal starts over empty
+     * @param filename The file that was written
+     * @param out Stream for status messages
+     */
+    void snapshotSaved(const string& filename, ostream& out) {
+        error_code ignored;
+        if (file == nullptr || snapshotFile.empty() || !filesystem::equivalent(filename, snapshotFile, ignored)) {
+            return;
+        }
+        if (reset()) {
+            out << "Journal cleared: " << snapshotFile << " now contains every change." << endl;
+        }
+    }
+
+    /**
+     * Start a new empty journal after the catalog was saved over its base file
+     * @return True if the journal was reset
+     */
+    bool reset() {
+        if (file == nullptr) {
+            return false;
+        }
+        fclose(file);
+        file = nullptr;
+        pending.clear();
+        undoStack.clear();
+        if (!writeHeader(journalPath, base)) {
+            return false;
+        }
+        file = fopen(journalPath.c_str(), "ab");
+        return file != nullptr;
+    }
+
+    /**
+     * Apply one record to the catalog (used for replay and undo)
+     * @param hashTable Reference to the hash table containing courses
+     * @param record The record to apply
+     * @return False if the record does not fit the current catalog
+     */
+    static bool applyRecord(HashTable& hashTable, const Record& record) {
+        switch (record.type) {
+            case AddCourse:
+                if (hashTable.find(record.course.courseNumber) != nullptr) {
+                    return false;
+                }
+                hashTable.insert(record.course);
+                return true;
+
+            case RemoveCourse:
+                return hashTable.remove(record.course.courseNumber);
+
+            case StripPrerequisite:
+                // Check every position first so a mismatch changes nothing
+                for (const auto& position : record.positions) {
+                    const Course* course = hashTable.find(position.first);
+                    if (course == nullptr || position.second >= course->prerequisites.size() ||
+                        course->prerequisites[position.second] != record.prerequisite) {
+                        return false;
+                    }
+                }
+                // Erase from the highest index down so earlier indexes stay valid
+                for (auto it = record.positions.rbegin(); it != record.positions.rend(); ++it) {
+                    Course* course = hashTable.search(it->first);
+                    course->prerequisites.erase(course->prerequisites.begin() + it->second);
+                }
+                return true;
+
+            case UpdateCourse: {
+                // Only replace the course if it is still in the state the edit started from
+                Course* course = hashTable.search(record.course.courseNumber);
+                if (course == nullptr || course->title() != record.previous.title() ||
+                    course->prerequisites != record.previous.prerequisites) {
+                    return false;
+                }
+                course->setTitle(record.course.courseTitle);
+                course->prerequisites = record.course.prerequisites;
+                return true;
+            }
+
+            case RestorePrerequisite: {
+                // Check every position first (each insert grows its course by one)
+                unordered_map<string, size_t> inserted;
+                for (const auto& position : record.positions) {
+                    const Course* course = hashTable.find(position.first);
+                    if (course == nullptr || position.second > course->prerequisites.size() + inserted[position.first]++) {
+                        return false;
+                    }
+                }
+                for (const auto& position : record.positions) {
+                    Course* course = hashTable.search(position.first);
+                    course->prerequisites.insert(course->prerequisites.begin() + position.second, record.prerequisite);
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    static constexpr const char* MAGIC = "ABCUJRN1";
+    static const size_t JOURNAL_GROUP_COMMIT_BYTES = 1 << 20;
+    static const size_t UNDO_REPORT_LIMIT = 10;
+
+    // FNV-1a, enough to detect torn and corrupted records
+    static uint32_t checksum(const char* data, size_t length) {
+        uint32_t hashValue = 2166136261u;
+        for (size_t i = 0; i < length; ++i) {
+            hashValue = (hashValue ^ static_cast<unsigned char>(data[i])) * 16777619u;
+        }
+        return hashValue;
+    }
+
+    static void putU32(string& buffer, uint32_t value) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            buffer += static_cast<char>((value >> shift) & 0xFF);
+        }
+    }
+
+    static void putString(string& buffer, const string& text) {
+        putU32(buffer, static_cast<uint32_t>(text.size()));
+        buffer += text;
+    }
+
+    // Bounds-checked reader over a byte range
+    struct Reader {
+        const string& data;
+        size_t offset;
+        size_t end;
+
+        bool getU32(uint32_t& value) {
+            if (end - offset < 4) {
+                return false;
+            }
+            value = 0;
+            for (int shift = 0; shift < 32; shift += 8) {
+                value |= static_cast<uint32_t>(static_cast<unsigned char>(data[offset++])) << shift;
+            }
+            return true;
+        }
+
+        bool getString(string& text) {
+            uint32_t length;
+            if (!getU32(length) || end - offset < length) {
+                return false;
+            }
+            text.assign(data, offset, length);
+            offset += length;
+            return true;
+        }
+
+        bool getCourse(Course& course) {
+            uint32_t count;
+            if (!getString(course.courseNumber) || !getString(course.courseTitle) || !getU32(count)) {
+                return false;
+            }
+            // Every prerequisite takes at least four bytes, which bounds a corrupt count
+            if (count > (end - offset) / 4) {
+                return false;
+            }
+            course.prerequisites.resize(count);
+            for (auto& prereq : course.prerequisites) {
+                if (!getString(prereq)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    static string describe(const Record& record) {
+        return record.type == StripPrerequisite || record.type == RestorePrerequisite ? record.prerequisite : record.course.courseNumber;
+    }
+
+    static string describeChange(const Record& record) {
+        switch (record.type) {
+            case AddCourse: return "add of " + describe(record);
+            case RemoveCourse: return "removal of " + describe(record);
+            case UpdateCourse: return "edit of " + describe(record);
+            default: return "prerequisite cleanup of " + describe(record);
+        }
+    }
+
+    static void putCourse(string& buffer, const Course& course) {
+        putString(buffer, course.courseNumber);
+        putString(buffer, course.courseTitle);
+        putU32(buffer, static_cast<uint32_t>(course.prerequisites.size()));
+        for (const auto& prereq : course.prerequisites) {
+            putString(buffer, prereq);
+        }
+    }
+
+    static string encodeBody(const Record& record) {
+        string body;
+        body += static_cast<char>(record.type);
+        body += static_cast<char>(record.flags);
+        putU32(body, record.operationId);
+        if (record.type == AddCourse || record.type == RemoveCourse || record.type == UpdateCourse) {
+            putCourse(body, record.course);
+            if (record.type == UpdateCourse) {
+                putCourse(body, record.previous);
+            }
+        } else {
+            putString(body, record.prerequisite);
+            putU32(body, static_cast<uint32_t>(record.positions.size()));
+            for (const auto& position : record.positions) {
+                putString(body, position.first);
+                putU32(body, position.second);
+            }
+        }
+        return body;
+    }
+
+    static bool decodeBody(const string& data, size_t offset, size_t end, Record& record) {
+        if (end - offset < 6) {
+            return false;
+        }
+        record.type = static_cast<RecordType>(data[offset]);
+        record.flags = static_cast<uint8_t>(data[offset + 1]);
+        Reader reader{data, offset + 2, end};
+        if (!reader.getU32(record.operationId)) {
+            return false;
+        }
+
+        uint32_t count;
+        if (record.type == AddCourse || record.type == RemoveCourse) {
+            return reader.getCourse(record.course) && reader.offset == end;
+        }
+        if (record.type == UpdateCourse) {
+            return reader.getCourse(record.course) && reader.getCourse(record.previous) && reader.offset == end;
+        }
+        if (record.type == StripPrerequisite || record.type == RestorePrerequisite) {
+            if (!reader.getString(record.prerequisite) || !reader.getU32(count)) {
+                return false;
+            }
+            for (uint32_t i = 0; i < count; ++i) {
+                pair<string, uint32_t> position;
+                if (!reader.getString(position.first) || !reader.getU32(position.second)) {
+                    return false;
+                }
+                record.positions.push_back(position);
+            }
+            return reader.offset == end;
+        }
+        return false;
+    }
+
+    static bool writeHeader(const string& path, const string& baseDescription) {
+        string header = MAGIC;
+        putString(header, baseDescription);
+        ofstream headerFile(path, ios::binary | ios::trunc);
+        headerFile.write(header.data(), static_cast<streamsize>(header.size()));
+        return static_cast<bool>(headerFile);
+    }
+
+    // Track operation groups so undo knows what is still undoable
+    void trackForUndo(const Record& record) {
+        if (record.flags & UNDO_FLAG) {
+            if (!undoStack.empty() && undoStack.back().front().operationId == record.operationId) {
+                undoStack.pop_back();
+            }
+            return;
+        }
+        if (undoStack.empty() || undoStack.back().front().operationId != record.operationId) {
+            undoStack.emplace_back();
+        }
+        undoStack.back().push_back(record);
+    }
+
+    void appendEncoded(const Record& record) {
+        ++appendedRecords;
+        string body = encodeBody(record);
+        putU32(pending, static_cast<uint32_t>(body.size()));
+        pending += body;
+        putU32(pending, checksum(body.data(), body.size()));
+        if (pending.size() >= JOURNAL_GROUP_COMMIT_BYTES) {
+            commit();
+        }
+    }
+
+    void append(Record& record) {
+        if (file == nullptr) {
+            return;
+        }
+        record.operationId = currentOperationId;
+        appendEncoded(record);
+        trackForUndo(record);
+    }
+
+    /**
+     * Validate the header, then apply every intact record in order
+     * @return False if the journal belongs to different base files
+     */
+    bool replay(const string& path, const string& contents, const string& baseDescription, HashTable& hashTable, ostream& out) {
+        const size_t magicLength = strlen(MAGIC);
+        Reader header{contents, magicLength, contents.size()};
+        string journalBase;
+        if (contents.compare(0, magicLength, MAGIC) != 0 || !header.getString(journalBase)) {
+            out << "Warning: '" << path << "' is not a course journal; changes will not be saved." << endl;
+            return false;
+        }
+        if (journalBase != baseDescription) {
+            out << "Warning: Journal '" << path << "' was recorded for " << journalBase
+                << "; changes will not be saved for this load." << endl;
+            return false;
+        }
+
+        size_t offset = header.offset;
+        size_t applied = 0;
+        size_t rejected = 0;
+        while (true) {
+            Reader reader{contents, offset, contents.size()};
+            uint32_t bodyLength = 0;
+            uint32_t storedChecksum = 0;
+            if (!reader.getU32(bodyLength) || contents.size() - reader.offset < static_cast<size_t>(bodyLength) + 4) {
+                break;
+            }
+            size_t bodyStart = reader.offset;
+            reader.offset += bodyLength;
+            reader.getU32(storedChecksum);
+
+            Record record;
+            if (storedChecksum != checksum(contents.data() + bodyStart, bodyLength) ||
+                !decodeBody(contents, bodyStart, bodyStart + bodyLength, record)) {
+                break;
+            }
+            offset = reader.offset;
+
+            nextOperationId = max(nextOperationId, record.operationId + 1);
+            if (applyRecord(hashTable, record)) {
+                ++applied;
+                trackForUndo(record);
+            } else {
+                ++rejected;
+            }
+        }
+
+        // Crash recovery: drop a torn or corrupt tail so new records follow intact ones
+        if (offset < contents.size()) {
+            error_code ignored;
+            filesystem::resize_file(path, offset, ignored);
+            out << "Recovered journal: discarded " << (contents.size() - offset) << " bytes of incomplete record data." << endl;
+        }
+        if (applied > 0 || rejected > 0) {
+            out << "Replayed " << applied << " journaled changes from " << path << "." << endl;
+        }
+        if (rejected > 0) {
+            out << "Warning: " << rejected << " journaled changes no longer matched the catalog and were skipped." << endl;
+        }
+        return true;
+    }
+
+    FILE* file = nullptr;
+    string journalPath;
+    string base;
+    string snapshotFile;               // Export target that makes the journal redundant
+    string pending;                    // Encoded records waiting for the next group commit
+    uint32_t currentOperationId = 0;
+    uint32_t nextOperationId = 1;
+    uint64_t appendedRecords = 0;
+    bool writeFailed = false;          // A commit failed; reported once by the next commit()
+    vector<vector<Record>> undoStack;  // Operations not yet undone, oldest first
+};
+
+/**
+ * Open the journal that belongs to a set of loaded files and replay it
+ * The journal lives next to the first file as "<file>.journal"
+ * @param journal The journal to open
+ * @param filenames The files that were just loaded
+ * @param hashTable The freshly loaded catalog
+ * @param out Stream for replay messages
+ */
+void openJournalForLoad(CourseJournal& journal, const vector<string>& filenames, HashTable& hashTable, ostream& out = cout) {
+    string baseDescription;
+    for (const auto& name : filenames) {
+        baseDescription += (baseDescription.empty() ? "" : ", ") + filesystem::path(name).filename().string();
+    }
+    journal.open(filenames[0] + ".journal", baseDescription, filenames.size() == 1 ? filenames[0] : "", hashTable, out);
+}
+
+//=============================================================================
+// Utility Functions
+//=============================================================================
+
+/**
+ * Converts a string to uppercase
+ * @param str The string to convert
+ * @return The uppercase version of the string
+ */
+string toUpperCase(string str) {
+    transform(str.begin(), str.end(), str.begin(), ::toupper);
+    return str;
+}   
+// Remove a prerequisite from all courses in the hash table
+void removePrerequisiteFromAllCourses(HashTable& hashTable, const string& removedCourseNumber, CourseJournal* journal = nullptr) {
+    // Remember where each occurrence was so the cleanup can be undone
+    vector<pair<string, uint32_t>> positions;
+    vector<string> affectedCourses;
+    const CourseColumns& columns = hashTable.columns();
+    for (uint32_t row : columns.rowsRequiring(columns.keyId(removedCourseNumber))) {
+        affectedCourses.emplace_back(columns.key(row));
+    }
+    for (const auto& courseNumber : affectedCourses) {
+        auto& prereqs = hashTable.search(courseNumber)->prerequisites;
+        for (size_t i = 0; i < prereqs.size(); ++i) {
+            if (prereqs[i] == removedCourseNumber) {
+                positions.emplace_back(courseNumber, static_cast<uint32_t>(i));
+            }
+        }
+        prereqs.erase(remove(prereqs.begin(), prereqs.end(), removedCourseNumber), prereqs.end());
+    }
+    if (journal != nullptr && !positions.empty()) {
+        journal->recordStrip(removedCourseNumber, positions);
+    }
+}
+/**
+ * Trims leading and trailing whitespace from a string
+ * @param str The string to trim
+ * @return The trimmed string
+ */
+string trim(const string& str) {
+    size_t first = str.find_first_not_of(" \t\r\n");
+        if (first == string::npos)
+            return "";
+    size_t last = str.find_last_not_of(" \t\r\n");
+    return str.substr(first, (last - first + 1));
+}
+
+/**
+ * Split a string by a delimiter
+ * @param str The string to split
+ * @param delimiter The delimiter character
+ * @return A vector of tokens
+ */
+
+ vector<string> split(const string& str, char delimiter) {
+    vector<string> tokens;
+    tokens.reserve(count(str.begin(), str.end(), delimiter) + 1);
+
+    // Each token is trimmed in place and copied out once; like getline,
+    // a trailing delimiter does not produce an empty last token
+    size_t start = 0;
+    while (start < str.size()) {
+        size_t end = str.find(delimiter, start);
+        if (end == string::npos) {
+            end = str.size();
+        }
+        size_t first = str.find_first_not_of(" \t\r\n", start);
+        if (first == string::npos || first >= end) {
+            tokens.emplace_back();
+        } else {
+            size_t last = str.find_last_not_of(" \t\r\n", end - 1);
+            tokens.emplace_back(str, first, last - first + 1);
+        }
+        start = end + 1;
+    }
+
+    return tokens;
+ }
+
+/**
+ * Parse a file selection from the load menu
+ * @param input A file number, several numbers separated by commas, or "all"
+ * @param fileCount Number of files offered
+ * @param choices Set to the selected 1-based file numbers, without duplicates
+ * @return False if the selection is empty or contains an invalid number
+ */
+bool parseFileSelection(const string& input, size_t fileCount, vector<size_t>& choices) {
+    choices.clear();
+    if (toUpperCase(trim(input)) == "ALL") {
+        for (size_t i = 1; i <= fileCount; ++i) {
+            choices.push_back(i);
+        }
+        return fileCount > 0;
+    }
+
+    for (const auto& token : split(input, ',')) {
+        if (token.empty() || token.find_first_not_of("0123456789") != string::npos || token.size() > 9) {
+            return false;
+        }
+        size_t choice = stoul(token);
+        if (choice < 1 || choice > fileCount) {
+            return false;
+        }
+        if (find(choices.begin(), choices.end(), choice) == choices.end()) {
+            choices.push_back(choice);
+        }
+    }
+    return !choices.empty();
+}
+
+ //=============================================================================
+ // Core Functionality Functions
+ //=============================================================================
+
+/**
+ * Parse one CSV line (number,title,prereq,...) into a course
+ * @param line The raw line from the file
+ * @param course The course to fill in
+ * @return False if the line is missing the course number or title
+ */
+bool parseCourseLine(const string& line, Course& course) {
+    // Parse the line
+    vector<string> tokens = split(line, ',');
+
+    // Validate the number of tokens (at least course number and title)
+    if (tokens.size() < 2) {
+        return false;
+    }
+
+    // The tokens are moved into the course, so each string is allocated once
+    course.courseNumber = toUpperCase(std::move(tokens[0]));
+    course.courseTitle = std::move(tokens[1]);
+
+    // Extract prerequisites if they exist (tokens from index 2 onward)
+    course.prerequisites.reserve(tokens.size() - 2);
+    for (size_t i = 2; i < tokens.size(); ++i) {
+        if (!tokens[i].empty()) {
+            course.prerequisites.push_back(toUpperCase(std::move(tokens[i])));
+        }
+    }
+    return true;
+}
+
+/**
+ * Courses parsed from one CSV file, kept apart until the merge step so
+ * that conflicts can be reported against the file and line they came from
+ */
+struct ParsedCatalogFile {
+    string filename;
+    bool lazyTitles = false;  // Map the file and leave titles as views into it
+    vector<Course> courses;
+    vector<int> lineNumbers;  // Source line of each course
+    bool opened = false;
+    int errorLine = 0;        // First malformed line, 0 if none
+    string errorText;         // Contents of that line
+    string readError;         // Why a compressed file could not be read to the end
+    shared_ptr<const MappedCatalogFile> titleSource; // The mapping, for lazy parses
+};
+
+// Set by --lazy-titles: catalog loads map their files and parse only the
+// course numbers and prerequisites, leaving titles in the mapped file
+bool lazyTitleLoading = false;
+
+/**
+ * Trim whitespace from both ends of a view without copying it
+ * @param text The text to trim
+ * @return The trimmed view
+ */
+string_view trimView(string_view text) {
+    size_t first = text.find_first_not_of(" \t\r\n");
+    if (first == string_view::npos) {
+        return text.substr(0, 0);
+    }
+    return text.substr(first, text.find_last_not_of(" \t\r\n") - first + 1);
+}
+
+/**
+ * Parse one line of a mapped catalog file; the same format and checks as
+ * parseCourseLine, but the title is left as a view into the line
+ * @param line The line, inside the mapping
+ * @param course The course to fill in
+ * @return False if the line is missing the course number or title
+ */
+bool parseMappedCourseLine(string_view line, Course& course) {
+    size_t tokenCount = 0;
+    size_t commas = count(line.begin(), line.end(), ',');
+    course.prerequisites.reserve(commas > 0 ? commas - 1 : 0);
+    // Like split(), a trailing delimiter does not produce an empty last token
+    for (size_t start = 0; start < line.size(); ++tokenCount) {
+        size_t end = min(line.find(',', start), line.size());
+        string_view token = trimView(line.substr(start, end - start));
+        if (tokenCount == 0) {
+            course.courseNumber = toUpperCase(string(token));
+        } else if (tokenCount == 1) {
+            course.titleSource = token;
+        } else if (!token.empty()) {
+            course.prerequisites.push_back(toUpperCase(string(token)));
+        }
+        start = end + 1;
+    }
+    return tokenCount >= 2;
+}
+
+/**
+ * Parse a mapped catalog file line by line, stopping at the first
+ * malformed line; the courses' titles point into parsed.titleSource
+ * @param parsed The result; parsed.filename names the file to map
+ */
+void parseMappedCourseFile(ParsedCatalogFile& parsed) {
+    auto source = make_shared<MappedCatalogFile>();
+    if (!source->open(parsed.filename)) {
+        return;
+    }
+    parsed.opened = true;
+    parsed.titleSource = source;
+
+    string_view text = source->text();
+    int lineNumber = 0;
+    for (size_t start = 0; start < text.size();) {
+        size_t end = min(text.find('\n', start), text.size());
+        string_view line = text.substr(start, end - start);
+        start = end + 1;
+        lineNumber++;
+
+        // Skip empty lines
+        if (line.find_first_not_of(" \t\r\n") == string_view::npos) {
+            continue;
+        }
+
+        Course course;
+        if (!parseMappedCourseLine(line, course)) {
+            parsed.errorLine = lineNumber;
+            parsed.errorText = string(line);
+            return;
+        }
+
+        parsed.courses.push_back(std::move(course));
+        parsed.lineNumbers.push_back(lineNumber);
+    }
+    source->releaseResidentPages();
+}
+
+/**
+ * Parse every line of a CSV file, stopping at the first malformed line
+ * @param parsed The result; parsed.filename names the file to read
+ */
+void parseCourseFile(ParsedCatalogFile& parsed) {
+    // A compressed file cannot be mapped, so its titles are read eagerly
+    if (parsed.lazyTitles && catalogCompressionOf(parsed.filename) == CatalogCompression::None) {
+        parseMappedCourseFile(parsed);
+        return;
+    }
+    CatalogLineReader file;
+    if (!file.open(parsed.filename)) {
+        return;
+    }
+    parsed.opened = true;
+
+    string line;
+    int lineNumber = 0;
+
+    // Read file line by line; compressed files are decompressed alongside
+    while (file.getline(line)) {
+        lineNumber++;
+
+        // Skip empty lines
+        if (line.find_first_not_of(" \t\r\n") == string::npos) {
+            continue;
+        }
+
+        // Create a Course object from the line
+        Course course;
+        if (!parseCourseLine(line, course)) {
+            parsed.errorLine = lineNumber;
+            parsed.errorText = line;
+            return;
+        }
+
+        parsed.courses.push_back(std::move(course));
+        parsed.lineNumbers.push_back(lineNumber);
+    }
+    parsed.readError = file.error();
+}
+
+/**
+ * Validate the merged contents of one or more parsed files in a single pass:
+ * every course number must be unique across all files, and every
+ * prerequisite must name a course in one of the files
+ * @param files The parsed files
+ * @param out Stream for merge statistics (multi-file loads only)
+ * @param err Stream for error messages
+ * @param existing Catalog the files will be added to, or nullptr for a fresh
+ *        load; its courses count as defined and may not be redefined
+ * @return True if the combined catalog is valid
+ */
+bool validateCatalog(const vector<ParsedCatalogFile>& files, ostream& out, ostream& err, const HashTable* existing = nullptr) {
+    // Course number -> (file index, course index) of its definition
+    unordered_map<string, pair<size_t, size_t>> definitions;
+    size_t totalCourses = 0;
+    for (const auto& parsed : files) {
+        totalCourses += parsed.courses.size();
+    }
+    definitions.reserve(totalCourses);
+
+    bool valid = true;
+    size_t existingConflicts = 0;
+    for (size_t f = 0; f < files.size(); ++f) {
+        for (size_t c = 0; c < files[f].courses.size(); ++c) {
+            if (existing != nullptr && existing->find(files[f].courses[c].courseNumber) != nullptr) {
+                // Re-adding a whole file would otherwise print one line per course
+                if (++existingConflicts <= 10) {
+                    err << "Error: Course '" << files[f].courses[c].courseNumber << "' (" << files[f].filename
+                        << " line " << files[f].lineNumbers[c] << ") already exists." << endl;
+                }
+                valid = false;
+                continue;
+            }
+            auto inserted = definitions.emplace(files[f].courses[c].courseNumber, make_pair(f, c));
+            if (!inserted.second) {
+                const auto& first = inserted.first->second;
+                err << "Error: Course '" << files[f].courses[c].courseNumber << "' is defined twice: "
+                    << files[first.first].filename << " line " << files[first.first].lineNumbers[first.second]
+                    << " and " << files[f].filename << " line " << files[f].lineNumbers[c] << endl;
+                valid = false;
+            }
+        }
+    }
+    if (existingConflicts > 10) {
+        err << "... and " << (existingConflicts - 10) << " more courses already exist." << endl;
+    }
+    if (!valid) {
+        return false;
+    }
+
+    // Validate that all prerequisites exist as courses
+    size_t crossFilePrerequisites = 0;
+    for (size_t f = 0; f < files.size(); ++f) {
+        for (const auto& course : files[f].courses) {
+            for (const auto& prereq : course.prerequisites) {
+                auto found = definitions.find(prereq);
+                if (found == definitions.end() && existing != nullptr && existing->find(prereq) != nullptr) {
+                    continue;
+                }
+                if (found == definitions.end()) {
+                    err << "Error: Prerequisite '" << prereq << "' for course '"
+                         << course.courseNumber << "' does not exist in the course list." << endl;
+                    return false;
+                }
+                if (found->second.first != f) {
+                    ++crossFilePrerequisites;
+                }
+            }
+        }
+    }
+
+    if (files.size() > 1) {
+        out << crossFilePrerequisites << " prerequisites resolved across files." << endl;
+    }
+    return true;
+}
+
+/**
+ * Load and merge course data from one or more CSV files, replacing the
+ * catalog in the hash table
+ * Files are parsed concurrently, validated together in one pass, and only
+ * then inserted into a fresh table by one bulk insert spread across all
+ * cores, which is swapped in; on any error the hash table is unchanged
+ * @param filenames Paths to the CSV files
+ * @param hashTable Reference to the hash table
+ * @param out Stream for progress and timing output
+ * @param err Stream for error messages
+ * @return True if loading is successful, false otherwise
+ */
+bool loadCourseFiles(const vector<string>& filenames, HashTable& hashTable, ostream& out = cout, ostream& err = cerr) {
+    // Start timing
+    auto startTime = high_resolution_clock::now();
+    clock_t startTicks = clock();
+
+    vector<ParsedCatalogFile> files(filenames.size());
+    for (size_t f = 0; f < filenames.size(); ++f) {
+        files[f].filename = filenames[f];
+        files[f].lazyTitles = lazyTitleLoading;
+    }
+
+    // One parser thread per extra file; the calling thread parses the first
+    vector<thread> parsers;
+    for (size_t f = 1; f < files.size(); ++f) {
+        parsers.emplace_back(parseCourseFile, ref(files[f]));
+    }
+    parseCourseFile(files[0]);
+    for (auto& parser : parsers) {
+        parser.join();
+    }
+
+    // Report in file order once every parser has finished
+    bool parsedAll = true;
+    for (const auto& parsed : files) {
+        // Check if file opened successfully
+        if (!parsed.opened) {
+            err << "Error: Could not open file " << parsed.filename << "'" << endl;
+            parsedAll = false;
+            continue;
+        }
+        out << parsed.filename << " loaded successfully!" << endl;
+
+        if (parsed.errorLine != 0) {
+            err << "Error: " << (files.size() > 1 ? parsed.filename + " line " : "Line ") << parsed.errorLine
+                << " - Invalid format (missing course number or title)" << endl;
+            err << "Line: " << parsed.errorText << endl;
+            parsedAll = false;
+        }
+        if (!parsed.readError.empty()) {
+            err << "Error: " << parsed.filename << ": " << parsed.readError << endl;
+            parsedAll = false;
+        }
+    }
+    if (!parsedAll || !validateCatalog(files, out, err)) {
+        return false;
+    }
+
+    // All validations passed, merge and insert courses into a fresh table
+    HashTable loadedTable;
+    vector<Course> mergedCourses;
+    for (auto& parsed : files) {
+        if (parsed.titleSource) {
+            loadedTable.keepTitleSource(std::move(parsed.titleSource));
+        }
+        mergedCourses.insert(mergedCourses.end(), make_move_iterator(parsed.courses.begin()),
+                             make_move_iterator(parsed.courses.end()));
+    }
+    size_t loadedCount = mergedCourses.size();
+    size_t dropped = loadedTable.insertAllConcurrent(std::move(mergedCourses), max(1u, thread::hardware_concurrency()));
+    // Validation rejects duplicate course numbers and the table starts empty
+    assert(dropped == 0);
+    (void)dropped;
+    hashTable.swap(loadedTable);
+
+    // End timing
+    auto endTime = high_resolution_clock::now();
+    clock_t endTicks = clock();
+
+    // Calculate elapsed time
+    auto duration = duration_cast<microseconds>(endTime - startTime);
+    double seconds = duration.count() / 1000000.0;
+    clock_t ticks = endTicks - startTicks;
+
+    // Display performance metrics
+    out << loadedCount << " courses loaded." << endl;
+    out << "Time to load: " << ticks << " clock ticks" << endl;
+    out << "Time to load: " << fixed << setprecision(6) << seconds << " seconds" << endl;
+
+    return true;
+}
+
+/**
+ * Load course data from CSV file into hash table
+ * @param filename Path to the CSV file
+ * @param hashTable Reference to the hash table
+ * @param out Stream for progress and timing output
+ * @param err Stream for error messages
+ * @return True if loading is successful, false otherwise
+ */
+bool loadCourseData(const string& filename, HashTable& hashTable, ostream& out = cout, ostream& err = cerr) {
+    return loadCourseFiles({filename}, hashTable, out, err);
+}
+
+//=============================================================================
+// Catalog Validation
+//=============================================================================
+
+// Kinds of problems reported by validateCatalogFiles, in report order within a line
+enum class CatalogIssueKind {
+    UnreadableFile,      // The file could not be opened
+    MalformedLine,       // Missing course number or title
+    DuplicateCourse,     // Course number already defined earlier
+    MissingPrerequisite  // Prerequisite that no course in the files defines
+};
+
+// One problem found by validateCatalogFiles
+struct CatalogIssue {
+    CatalogIssueKind kind;
+    size_t file;    // Index into the validated file list
+    int line;       // 1-based line, 0 for the whole file
+    string value;   // The offending line, course number or prerequisite
+    string detail;  // Where it was first defined, or which course requires it
+};
+
+/**
+ * Courses and malformed lines from one slice of a mapped catalog file
+ * Line numbers are relative to the slice until the slices are joined.
+ */
+struct CatalogSliceScan {
+    string_view text;
+    vector<Course> courses;
+    vector<int> lineNumbers;
+    vector<CatalogIssue> issues;
+    int lineCount = 0;
+};
+
+/**
+ * Parse every line of one slice, recording malformed lines instead of stopping
+ * @param scan The slice to scan; scan.text must start at a line boundary
+ * @param file Index of the file the slice belongs to
+ */
+void scanCatalogSlice(CatalogSliceScan& scan, size_t file) {
+    string_view text = scan.text;
+    for (size_t start = 0; start < text.size();) {
+        size_t end = min(text.find('\n', start), text.size());
+        string_view line = text.substr(start, end - start);
+        start = end + 1;
+        scan.lineCount++;
+        if (line.find_first_not_of(" \t\r\n") == string_view::npos) {
+            continue;
+        }
+        Course course;
+        if (!parseMappedCourseLine(line, course)) {
+            scan.issues.push_back({CatalogIssueKind::MalformedLine, file, scan.lineCount, string(trimView(line)),
+                                   "missing course number or title"});
+            continue;
+        }
+        scan.courses.push_back(std::move(course));
+        scan.lineNumbers.push_back(scan.lineCount);
+    }
+}
+
+/**
+ * Check one or more catalog files completely, as loadCourseFiles would,
+ * but collect every problem instead of stopping at the first and build
+ * no catalog. Each file is mapped and cut into slices at line boundaries
+ * that are parsed in parallel; duplicate course numbers are then found
+ * in file order, and prerequisites are checked in parallel again.
+ * @param filenames Paths to the CSV files
+ * @param threadCount Number of threads to scan with
+ * @param courseCount Set to the number of well-formed course lines
+ * @return The problems, ordered by file, line and kind
+ */
+vector<CatalogIssue> validateCatalogFiles(const vector<string>& filenames, unsigned int threadCount, size_t& courseCount) {
+    const size_t MIN_SLICE_BYTES = 1 << 20;
+    vector<CatalogIssue> issues;
+    vector<unique_ptr<MappedCatalogFile>> sources;
+    deque<string> decompressed;  // Text of compressed files, which cannot be mapped
+    vector<CatalogSliceScan> slices;
+    vector<size_t> sliceFile;
+    for (size_t f = 0; f < filenames.size(); ++f) {
+        string_view text;
+        if (catalogCompressionOf(filenames[f]) != CatalogCompression::None) {
+            CatalogLineReader reader;
+            if (!reader.open(filenames[f])) {
+                issues.push_back({CatalogIssueKind::UnreadableFile, f, 0, filenames[f], "could not open file"});
+                continue;
+            }
+            string& contents = decompressed.emplace_back();
+            for (string line; reader.getline(line);) {
+                contents += line;
+                contents += '\n';
+            }
+            if (!reader.error().empty()) {
+                issues.push_back({CatalogIssueKind::UnreadableFile, f, 0, filenames[f], reader.error()});
+                continue;
+            }
+            text = contents;
+        } else {
+            auto source = make_unique<MappedCatalogFile>();
+            if (!source->open(filenames[f])) {
+                issues.push_back({CatalogIssueKind::UnreadableFile, f, 0, filenames[f], "could not open file"});
+                continue;
+            }
+            text = source->text();
+            sources.push_back(std::move(source));
+        }
+        size_t sliceCount = max<size_t>(1, min<size_t>(threadCount, text.size() / MIN_SLICE_BYTES));
+        size_t start = 0;
+        for (size_t i = 1; i <= sliceCount && start < text.size(); ++i) {
+            size_t end = i == sliceCount ? text.size() : max(start, text.size() * i / sliceCount);
+            end = min(text.find('\n', end), text.size() - 1) + 1;
+            CatalogSliceScan slice;
+            slice.text = text.substr(start, end - start);
+            slices.push_back(std::move(slice));
+            sliceFile.push_back(f);
+            start = end;
+        }
+    }
+
+    // Runs work(slice) for every slice, spreading the slices over the threads
+    auto forEachSlice = [&](auto work) {
+        atomic<size_t> nextSlice{0};
+        auto worker = [&]() {
+            for (size_t i = nextSlice++; i < slices.size(); i = nextSlice++) {
+                work(i);
+            }
+        };
+        vector<thread> workers;
+        for (unsigned int t = 1; t < min<size_t>(threadCount, slices.size()); ++t) {
+            workers.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : workers) {
+            thread.join();
+        }
+    };
+
+    forEachSlice([&](size_t i) { scanCatalogSlice(slices[i], sliceFile[i]); });
+
+    // Slice-relative line numbers become file line numbers
+    int firstLine = 0;
+    for (size_t i = 0; i < slices.size(); ++i) {
+        if (i > 0 && sliceFile[i] != sliceFile[i - 1]) {
+            firstLine = 0;
+        }
+        for (int& line : slices[i].lineNumbers) {
+            line += firstLine;
+        }
+        for (auto& issue : slices[i].issues) {
+            issue.line += firstLine;
+        }
+        firstLine += slices[i].lineCount;
+    }
+
+    // Course number -> (file, line) of its first definition, in file order
+    unordered_map<string_view, pair<size_t, int>> definitions;
+    courseCount = 0;
+    for (const auto& slice : slices) {
+        courseCount += slice.courses.size();
+    }
+    definitions.reserve(courseCount);
+    for (size_t i = 0; i < slices.size(); ++i) {
+        for (size_t c = 0; c < slices[i].courses.size(); ++c) {
+            const string& courseNumber = slices[i].courses[c].courseNumber;
+            auto inserted = definitions.emplace(courseNumber, make_pair(sliceFile[i], slices[i].lineNumbers[c]));
+            if (!inserted.second) {
+                const auto& first = inserted.first->second;
+                slices[i].issues.push_back({CatalogIssueKind::DuplicateCourse, sliceFile[i], slices[i].lineNumbers[c],
+                                            courseNumber, "first defined at " + filenames[first.first] + ":" +
+                                            to_string(first.second)});
+            }
+        }
+    }
+
+    forEachSlice([&](size_t i) {
+        CatalogSliceScan& slice = slices[i];
+        for (size_t c = 0; c < slice.courses.size(); ++c) {
+            for (const auto& prereq : slice.courses[c].prerequisites) {
+                if (definitions.find(prereq) == definitions.end()) {
+                    slice.issues.push_back({CatalogIssueKind::MissingPrerequisite, sliceFile[i], slice.lineNumbers[c],
+                                            prereq, "required by " + slice.courses[c].courseNumber});
+                }
+            }
+        }
+    });
+
+    for (auto& slice : slices) {
+        issues.insert(issues.end(), make_move_iterator(slice.issues.begin()), make_move_iterator(slice.issues.end()));
+    }
+    stable_sort(issues.begin(), issues.end(), [](const CatalogIssue& a, const CatalogIssue& b) {
+        return tie(a.file, a.line, a.kind) < tie(b.file, b.line, b.kind);
+    });
+    return issues;
+}
+
+/**
+ * Validate catalog files and print every problem, one per line:
+ *   <file>:<line>: <kind>: <value> (<detail>)
+ * followed by a summary with the count of each kind
+ * @param filenames Paths to the CSV files
+ * @param threadCount Number of threads to scan with
+ * @param out Stream for the report
+ * @return True if the files would load without errors
+ */
+bool printCatalogValidation(const vector<string>& filenames, unsigned int threadCount, ostream& out = cout) {
+    static const char* const KIND_NAMES[] = {"unreadable-file", "malformed-line", "duplicate-course",
+                                             "missing-prerequisite"};
+    auto startTime = high_resolution_clock::now();
+    size_t courseCount = 0;
+    vector<CatalogIssue> issues = validateCatalogFiles(filenames, threadCount, courseCount);
+    double seconds = duration_cast<microseconds>(high_resolution_clock::now() - startTime).count() / 1000000.0;
+
+    size_t kindCounts[4] = {};
+    for (const auto& issue : issues) {
+        ++kindCounts[static_cast<int>(issue.kind)];
+        out << filenames[issue.file] << ":" << issue.line << ": " << KIND_NAMES[static_cast<int>(issue.kind)] << ": "
+            << issue.value << " (" << issue.detail << ")\n";
+    }
+    out << courseCount << " courses checked in " << filenames.size() << (filenames.size() == 1 ? " file: " : " files: ")
+        << issues.size() << (issues.size() == 1 ? " error" : " errors");
+    if (!issues.empty()) {
+        const char* separator = " (";
+        for (int kind = 0; kind < 4; ++kind) {
+            if (kindCounts[kind] != 0) {
+                out << separator << kindCounts[kind] << " " << KIND_NAMES[kind];
+                separator = ", ";
+            }
+        }
+        out << ")";
+    }
+    out << "." << endl;
+    out << "Time to validate: " << fixed << setprecision(6) << seconds << " seconds" << endl;
+    return issues.empty();
+}
+
+/**
+ * Print all courses in alphanumeric order
+ * @param hashTable Reference to the hash table containing courses
+ * @param out Stream for the listing and timing output
+ * @param err Stream for error messages
+ * @return True if any courses were printed, false if none are loaded
+ */
+
+bool printCourseList(HashTable& hashTable, ostream& out = cout, ostream& err = cerr) {
+    // Start timing
+    auto startTime = high_resolution_clock::now();
+    clock_t startTicks = clock();
+
+    // The listing reads only the key and title columns
+    const CourseColumns& columns = hashTable.columns();
+    vector<uint32_t> rows = columns.liveRows();
+    
+    // Check if courses are loaded
+    if (rows.empty()) {
+        err << "No courses loaded. Please load data first (Option 1)." << endl;
+        return false;
+    } else {
+        out << "Courses loaded successfully!" << endl;
+    }
+
+    // Sort courses alphanumerically by course number
+    sortByCourseNumber(rows, [&columns](uint32_t row) { return columns.key(row); },
+                       max(1u, thread::hardware_concurrency()));
+        
+    // Print header
+    out << "Here is a sample schedule:" << endl;
+    out << endl;
+
+    // Print each course
+    for (uint32_t row : rows) {
+        out << columns.key(row) << ", " << columns.title(row) << '\n';
+    }
+    out.flush();
+
+    // End timing
+    auto endTime = high_resolution_clock::now();
+    clock_t endTicks = clock();
+
+    // Calculate elapsed time
+    auto duration = duration_cast<microseconds>(endTime - startTime);
+    double seconds = duration.count() / 1000000.0;
+    clock_t ticks = endTicks - startTicks;
+
+    out << "Time to print: " << ticks << " clock ticks" << endl;
+    out << "Time to print: " << fixed << setprecision(6) << seconds << " seconds" << endl;
+    out << endl;
+    return true;
+}
+
+/**
+ * Parse a department query: "CSCI", "CSCI 300", "CSCI 300-399" or
+ * "CSCI300-CSCI399" (case and spaces ignored)
+ * @param query The query text
+ * @param department Set to the department prefix, uppercase
+ * @param lowLevel Set to the lowest course level wanted
+ * @param highLevel Set to the highest course level wanted
+ * @return False if the query is not in one of those forms
+ */
+bool parseDepartmentQuery(const string& query, string& department, uint32_t& lowLevel, uint32_t& highLevel) {
+    string text;
+    for (char ch : toUpperCase(query)) {
+        if (!isspace(static_cast<unsigned char>(ch))) {
+            text += ch;
+        }
+    }
+    department = string(DepartmentIndex::departmentOf(text));
+    if (department.empty()) {
+        return false;
+    }
+    lowLevel = 0;
+    highLevel = UINT32_MAX;
+    string_view rest = string_view(text).substr(department.size());
+    if (rest.empty()) {
+        return true;
+    }
+
+    auto readLevel = [&rest](uint32_t& level) {
+        size_t digits = 0;
+        while (digits < rest.size() && isdigit(static_cast<unsigned char>(rest[digits]))) {
+            ++digits;
+        }
+        if (digits == 0 || digits > 9) {
+            return false;
+        }
+        level = static_cast<uint32_t>(stoul(string(rest.substr(0, digits))));
+        rest.remove_prefix(digits);
+        return true;
+    };
+    if (!readLevel(lowLevel)) {
+        return false;
+    }
+    highLevel = lowLevel;
+    if (rest.empty()) {
+        return true;
+    }
+    if (rest[0] != '-') {
+        return false;
+    }
+    rest.remove_prefix(1);
+    // The upper bound may repeat the department ("CSCI300-CSCI399")
+    if (rest.compare(0, department.size(), department) == 0) {
+        rest.remove_prefix(department.size());
+    }
+    return readLevel(highLevel) && rest.empty() && lowLevel <= highLevel;
+}
+
+/**
+ * Print one department's courses, or a level range of them, in level
+ * order; with an empty query, list the departments and their sizes
+ * @param hashTable Reference to the hash table containing courses
+ * @param query "CSCI", "CSCI 300-399", ... (see parseDepartmentQuery), or ""
+ * @param out Stream for the listing and timing output
+ * @return True if the query was valid and matched at least one course
+ */
+bool printDepartmentCourses(HashTable& hashTable, const string& query, ostream& out = cout) {
+    auto startTime = high_resolution_clock::now();
+    const DepartmentIndex& index = hashTable.departments(max(1u, thread::hardware_concurrency()));
+
+    if (trim(query).empty()) {
+        vector<pair<string, size_t>> departments = index.departments();
+        if (departments.empty()) {
+            out << "No courses loaded. Please load data first (Option 1)." << endl;
+            return false;
+        }
+        for (const auto& department : departments) {
+            out << (department.first.empty() ? "(no prefix)" : department.first) << ": "
+                << department.second << (department.second == 1 ? " course" : " courses") << '\n';
+        }
+        out.flush();
+        return true;
+    }
+
+    string department;
+    uint32_t lowLevel = 0;
+    uint32_t highLevel = 0;
+    if (!parseDepartmentQuery(query, department, lowLevel, highLevel)) {
+        out << "Error: Expected a department such as CSCI, optionally with a level range such as 300-399." << endl;
+        return false;
+    }
+    DepartmentIndex::Range courses = index.range(department, lowLevel, highLevel);
+    if (courses.size() == 0) {
+        out << "No courses found for '" << trim(query) << "'." << endl;
+        return false;
+    }
+    for (const auto& entry : courses) {
+        out << entry.course->courseNumber << ", " << entry.course->title() << '\n';
+    }
+
+    auto duration = duration_cast<microseconds>(high_resolution_clock::now() - startTime);
+    out << courses.size() << (courses.size() == 1 ? " course" : " courses") << " found" << endl;
+    out << "Time to print: " << fixed << setprecision(6) << duration.count() / 1000000.0 << " seconds" << endl;
+    return true;
+}
+
+/**
+ * Render the detail block printed for one course: the title line and the
+ * prerequisite line
+ * @param course The course to render
+ * @return The block, ending in a newline
+ */
+string renderCourseDetails(const Course& course) {
+    string block = course.courseNumber + ", ";
+    block += course.title();
+    block += "\nPrerequisites: ";
+    if (course.prerequisites.empty()) {
+        block += "None";
+    }
+    for (size_t i = 0; i < course.prerequisites.size(); ++i) {
+        if (i > 0) {
+            block += ", ";
+        }
+        block += course.prerequisites[i];
+    }
+    block += '\n';
+    return block;
+}
+
+/**
+ * Search for and print a specific course's information
+ * @param hashTable Reference to the hash table containing courses
+ * @param courseNumber The course number to search for
+ * @param out Stream for the course details and timing output
+ * @return True if the course was found and printed, false otherwise
+ */
+bool printCourseInformation(HashTable& hashTable, const string& courseNumber, ostream& out = cout) {
+    // Start timing
+    auto startTime = high_resolution_clock::now();
+    clock_t startTicks = clock();
+
+    // Validate input is not empty or whitespace
+    string trimmedCourse = trim(courseNumber);
+    if (trimmedCourse.empty()) {
+        out << "Error: Course number cannot be empty. Please enter a valid course number." << endl;
+        return false;
+    }
+
+    // Convert to uppercase for case-insensitive search
+    string searchNumber = toUpperCase(trimmedCourse);
+
+    // Popular courses are served from the rendered-details cache as one write
+    CourseDetailCache& cache = hashTable.renderedDetails();
+    const string* block = cache.get(searchNumber);
+    if (block == nullptr) {
+        // Search for the course
+        const Course* course = hashTable.find(searchNumber);
+        if (course == nullptr) {
+            out << "Error: Course '" << trimmedCourse << "' not found. Please enter a valid course number." << endl;
+            return false;
+        }
+        block = &cache.put(searchNumber, renderCourseDetails(*course));
+    }
+    out.write(block->data(), static_cast<streamsize>(block->size()));
+
+    // End timing
+    auto endTime = high_resolution_clock::now();
+    clock_t endTicks = clock();
+
+    // Calculate elapsed time
+    auto duration = duration_cast<microseconds>(endTime - startTime);
+    double seconds = duration.count() / 1000000.0;
+    clock_t ticks = endTicks - startTicks;
+
+    out << "Time to print: " << ticks << " clock ticks" << endl;
+    out << "Time to print: " << fixed << setprecision(6) << seconds << " seconds" << endl;
+    return true;
+}
+
+/**
+ * Validate a new course and insert it into the hash table
+ * @param hashTable Reference to the hash table containing courses
+ * @param newCourse The course to add (number and title already normalized)
+ * @param prereqInput Raw comma-separated prerequisite list ("" or "none" for none)
+ * @param out Stream for status and error messages
+ * @param journal Journal to record the change in, or nullptr
+ * @return True if the course was added, false if validation failed
+ */
+bool addCourseRecord(HashTable& hashTable, Course newCourse, const string& prereqInput, ostream& out = cout,
+                     CourseJournal* journal = nullptr) {
+    // Validate course number is not empty
+    if (newCourse.courseNumber.empty()) {
+        out << "Error: Course number cannot be empty." << endl;
+        return false;
+    }
+
+    // Check if course already exists
+    if (hashTable.find(newCourse.courseNumber) != nullptr) {
+        out << "Error: Course " << newCourse.courseNumber << " already exists." << endl;
+        return false;
+    }
+
+    // Validate course title is not empty
+    if (newCourse.courseTitle.empty()) {
+        out << "Error: Course title cannot be empty." << endl;
+        return false;
+    }
+
+    string normalizedInput = toUpperCase(trim(prereqInput));
+    if (!normalizedInput.empty() && normalizedInput != "NONE") {
+        vector<string> prereqs = split(prereqInput, ',');
+        // Validate each prerequisite exists in the hash table
+        // If a prerequisite does not exist, show an error and do not add the course
+        for (const auto& prereq : prereqs) {
+            string prereqNumber = toUpperCase(trim(prereq));
+            if (prereqNumber == "NONE" || prereqNumber.empty()) {
+                continue;
+            }
+            if (hashTable.find(prereqNumber) == nullptr) {
+                out << "Error: Prerequisite '" << prereqNumber << "' does not exist in the course list." << endl;
+                out << "Course not added. Please add prerequisites first." << endl;
+                return false;
+            }
+            newCourse.prerequisites.push_back(prereqNumber);
+        }
+    }
+
+    // Add the course to the hash table
+    const Course& added = hashTable.emplace(std::move(newCourse));
+    if (journal != nullptr) {
+        journal->recordAdd(added);
+    }
+    out << "Course '" << added.courseNumber << "' added successfully!" << endl;
+    return true;
+}
+
+/**
+ * Add a new course to the system
+ * @param hashTable Reference to the hash table containing courses
+ * @param journal Journal to record the change in, or nullptr
+ */
+void addCourse(HashTable& hashTable, CourseJournal* journal = nullptr) {
+    Course newCourse;
+    string input;
+
+    // Get course number
+    cout << "Enter course number (e.g., CSCI300): ";
+    getline(cin, input);
+    newCourse.courseNumber = toUpperCase(trim(input));
+
+    // Validate course number is not empty
+    if (newCourse.courseNumber.empty()) {
+        cout << "Error: Course number cannot be empty." << endl;
+        return;
+    }
+
+    // Check if course already exists
+    if (hashTable.find(newCourse.courseNumber) != nullptr) {
+        cout << "Error: Course " << newCourse.courseNumber << " already exists." << endl;
+        return;
+    }
+
+    // Get course title
+    cout << "Enter course title: ";
+    getline(cin, newCourse.courseTitle);
+
+    // Validate course title is not empty
+    if (newCourse.courseTitle.empty()) {
+        cout << "Error: Course title cannot be empty." << endl;
+        return;
+    }
+
+    // Get prerequisites
+    cout << "Enter prerequisites (comma-separated, leave blank or type 'none' if none): ";
+    getline(cin, input);
+
+    addCourseRecord(hashTable, newCourse, input, cout, journal);
+}
+
+/**
+ * Add every course in a CSV file (same layout as option 1) to the catalog
+ * The batch is validated as a set, so new courses may list other new
+ * courses as prerequisites; the table is then resized once and all
+ * courses are inserted in one pass. On any error nothing is added.
+ * @param filename Path to the CSV file of new courses
+ * @param hashTable Reference to the hash table containing courses
+ * @param out Stream for status and timing output
+ * @param err Stream for error messages
+ * @param journal Journal to record the change in, or nullptr
+ * @return True if the courses were added
+ */
+bool bulkAddCourses(const string& filename, HashTable& hashTable, ostream& out = cout, ostream& err = cerr,
+                    CourseJournal* journal = nullptr) {
+    // Start timing
+    auto startTime = high_resolution_clock::now();
+    clock_t startTicks = clock();
+
+    vector<ParsedCatalogFile> batch(1);
+    ParsedCatalogFile& parsed = batch[0];
+    parsed.filename = filename;
+    parseCourseFile(parsed);
+    if (!parsed.opened) {
+        err << "Error: Could not open file " << filename << "'" << endl;
+        return false;
+    }
+    if (parsed.errorLine != 0) {
+        err << "Error: Line " << parsed.errorLine << " - Invalid format (missing course number or title)" << endl;
+        err << "Line: " << parsed.errorText << endl;
+        return false;
+    }
+    if (!parsed.readError.empty()) {
+        err << "Error: " << filename << ": " << parsed.readError << endl;
+        return false;
+    }
+    if (parsed.courses.empty()) {
+        err << "Error: " << filename << " contains no courses." << endl;
+        return false;
+    }
+    if (!validateCatalog(batch, out, err, &hashTable)) {
+        err << "No courses were added." << endl;
+        return false;
+    }
+
+    if (journal != nullptr) {
+        for (const auto& course : parsed.courses) {
+            journal->recordAdd(course);
+        }
+    }
+    size_t addedCount = parsed.courses.size();
+    hashTable.insertAll(std::move(parsed.courses));
+
+    // End timing
+    auto endTime = high_resolution_clock::now();
+    clock_t endTicks = clock();
+
+    // Calculate elapsed time
+    auto duration = duration_cast<microseconds>(endTime - startTime);
+    double seconds = duration.count() / 1000000.0;
+    clock_t ticks = endTicks - startTicks;
+
+    out << addedCount << " courses added from " << filename << "." << endl;
+    out << "Time to add: " << ticks << " clock ticks" << endl;
+    out << "Time to add: " << fixed << setprecision(6) << seconds << " seconds" << endl;
+    return true;
+}
+
+/**
+ * Add courses in bulk from a CSV file chosen by the user
+ * @param hashTable Reference to the hash table containing courses
+ * @param journal Journal to record the change in, or nullptr
+ */
+void bulkAddFromFile(HashTable& hashTable, CourseJournal* journal = nullptr) {
+    vector<string> csvFiles = getCsvFilesInCurrentDir();
+    for (size_t i = 0; i < csvFiles.size(); ++i) {
+        cout << (i + 1) << ". " << csvFiles[i] << endl;
+    }
+    cout << "Enter the number or name of the file of new courses: ";
+    string selection;
+    getline(cin, selection);
+    selection = trim(selection);
+
+    vector<size_t> fileChoices;
+    if (parseFileSelection(selection, csvFiles.size(), fileChoices) && fileChoices.size() == 1) {
+        selection = csvFiles[fileChoices[0] - 1];
+    }
+    if (selection.empty()) {
+        cout << "Error: File name cannot be empty." << endl;
+        return;
+    }
+    bulkAddCourses(selection, hashTable, cout, cout, journal);
+}
+
+/**
+ * Check whether a course can reach another by following prerequisites
+ * Only the part of the catalog below startCourse is visited
+ * @param hashTable Reference to the hash table containing courses
+ * @param startCourse Course number to start from
+ * @param targetCourse Course number to look for
+ * @return True if targetCourse is startCourse or one of its (indirect) prerequisites
+ */
+bool prerequisiteChainReaches(HashTable& hashTable, const string& startCourse, const string& targetCourse) {
+    vector<string> pending{startCourse};
+    unordered_set<string> visited{startCourse};
+    while (!pending.empty()) {
+        string current = move(pending.back());
+        pending.pop_back();
+        if (current == targetCourse) {
+            return true;
+        }
+        const Course* course = hashTable.find(current);
+        if (course == nullptr) {
+            continue;
+        }
+        for (const auto& prereq : course->prerequisites) {
+            if (visited.insert(prereq).second) {
+                pending.push_back(prereq);
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * Change the title and/or prerequisites of a stored course in place
+ * Only prerequisites that are new to the course are validated: each must
+ * exist and must not lead back to the course itself
+ * @param hashTable Reference to the hash table containing courses
+ * @param courseNumber The course to edit
+ * @param newTitle The new title, or "" to keep the current one
+ * @param prereqInput Comma-separated prerequisites, "none" to clear them, or "" to keep them
+ * @param out Stream for status and error messages
+ * @param journal Journal to record the change in, or nullptr
+ * @return True if the course was changed
+ */
+bool editCourseRecord(HashTable& hashTable, const string& courseNumber, const string& newTitle, const string& prereqInput,
+                      ostream& out = cout, CourseJournal* journal = nullptr) {
+    string searchNumber = toUpperCase(trim(courseNumber));
+    const Course* course = hashTable.find(searchNumber);
+    if (course == nullptr) {
+        out << "Error: Course " << searchNumber << " not found." << endl;
+        return false;
+    }
+
+    string title = trim(newTitle);
+    if (title.empty()) {
+        title = string(course->title());
+    }
+
+    vector<string> prerequisites = course->prerequisites;
+    string normalizedInput = toUpperCase(trim(prereqInput));
+    if (!normalizedInput.empty()) {
+        prerequisites.clear();
+        if (normalizedInput != "NONE") {
+            for (const auto& prereq : split(prereqInput, ',')) {
+                string prereqNumber = toUpperCase(trim(prereq));
+                if (prereqNumber.empty() || prereqNumber == "NONE" ||
+                    find(prerequisites.begin(), prerequisites.end(), prereqNumber) != prerequisites.end()) {
+                    continue;
+                }
+
+                // Prerequisites the course already had were valid when they were added
+                bool alreadyListed = find(course->prerequisites.begin(), course->prerequisites.end(), prereqNumber) !=
+                                     course->prerequisites.end();
+                if (!alreadyListed) {
+                    if (hashTable.find(prereqNumber) == nullptr) {
+                        out << "Error: Prerequisite '" << prereqNumber << "' does not exist in the course list." << endl;
+                        out << "Course not changed." << endl;
+                        return false;
+                    }
+                    if (prerequisiteChainReaches(hashTable, prereqNumber, searchNumber)) {
+                        out << "Error: " << prereqNumber << " already requires " << searchNumber
+                            << " (directly or indirectly), so it cannot also be its prerequisite." << endl;
+                        out << "Course not changed." << endl;
+                        return false;
+                    }
+                }
+                prerequisites.push_back(prereqNumber);
+            }
+        }
+    }
+
+    if (title == course->title() && prerequisites == course->prerequisites) {
+        out << "No changes made to " << searchNumber << "." << endl;
+        return false;
+    }
+
+    Course before = *course;
+    Course* stored = hashTable.search(searchNumber);
+    stored->setTitle(move(title));
+    stored->prerequisites = move(prerequisites);
+    if (journal != nullptr) {
+        journal->recordUpdate(before, *stored);
+    }
+    out << "Course '" << searchNumber << "' updated successfully!" << endl;
+    return true;
+}
+
+/**
+ * Edit the title and prerequisites of an existing course
+ * @param hashTable Reference to the hash table containing courses
+ * @param journal Journal to record the change in, or nullptr
+ */
+void editCourse(HashTable& hashTable, CourseJournal* journal = nullptr) {
+    string courseNumber;
+    cout << "Enter course number to edit: ";
+    getline(cin, courseNumber);
+
+    const Course* course = hashTable.find(toUpperCase(trim(courseNumber)));
+    if (course == nullptr) {
+        cout << "Error: Course " << toUpperCase(trim(courseNumber)) << " not found." << endl;
+        return;
+    }
+
+    cout << "Current title: " << course->title() << endl;
+    cout << "Enter new title (leave blank to keep): ";
+    string newTitle;
+    getline(cin, newTitle);
+
+    cout << "Current prerequisites: ";
+    if (course->prerequisites.empty()) {
+        cout << "None";
+    }
+    for (size_t i = 0; i < course->prerequisites.size(); ++i) {
+        cout << (i > 0 ? ", " : "") << course->prerequisites[i];
+    }
+    cout << endl;
+    cout << "Enter new prerequisites (comma-separated, 'none' to clear, leave blank to keep): ";
+    string prereqInput;
+    getline(cin, prereqInput);
+
+    editCourseRecord(hashTable, courseNumber, newTitle, prereqInput, cout, journal);
+}
+
+/**
+ * Find every course that lists the given course as a prerequisite
+ * @param hashTable Reference to the hash table containing courses
+ * @param courseNumber The (normalized) course number to look for
+ * @return Course numbers of the dependent courses
+ */
+vector<string> findDependentCourses(HashTable& hashTable, const string& courseNumber) {
+    // Only the key and prerequisite columns are read
+    const CourseColumns& columns = hashTable.columns();
+    vector<string> dependentCourses;
+    for (uint32_t row : columns.rowsRequiring(columns.keyId(courseNumber))) {
+        dependentCourses.emplace_back(columns.key(row));
+    }
+    return dependentCourses;
+}
+
+/**
+ * Remove a single course, journaling a snapshot so the removal can be undone
+ * @param hashTable Reference to the hash table containing courses
+ * @param courseNumber The (normalized) course number to remove
+ * @param journal Journal to record the removal in, or nullptr
+ * @return True if the course was removed, false if not found
+ */
+bool removeCourseRecord(HashTable& hashTable, const string& courseNumber, CourseJournal* journal = nullptr) {
+    const Course* course = hashTable.find(courseNumber);
+    if (course == nullptr) {
+        return false;
+    }
+    if (journal != nullptr) {
+        journal->recordRemove(*course);
+    }
+    return hashTable.remove(courseNumber);
+}
+
+/**
+ * Remove a course from the system
+ * @param hashTable Reference to the hash table containing courses
+ * @param journal Journal to record the change in, or nullptr
+ */
+void removeCourse(HashTable& hashTable, CourseJournal* journal = nullptr) {
+    // Start timing
+    auto startTime = high_resolution_clock::now();
+    clock_t startTicks = clock();
+    
+    string courseNumber;
+    
+    cout << "Enter course number to remove: ";
+    getline(cin, courseNumber);
+    
+    string searchNumber = toUpperCase(trim(courseNumber));
+    
+    // Validate input
+    if (searchNumber.empty()) {
+        cout << "Error: Course number cannot be empty." << endl;
+        return;
+    }
+    
+    // Check if course exists
+    const Course* course = hashTable.find(searchNumber);
+    if (course == nullptr) {
+        cout << "Error: Course " << courseNumber << " not found." << endl;
+        return;
+    }
+    
+    // Check if this course is a prerequisite for other courses
+    vector<string> dependentCourses = findDependentCourses(hashTable, searchNumber);
+    
+    // Warn if course is a prerequisite
+    if (!dependentCourses.empty()) {
+        cout << endl;
+        cout << "WARNING: " << searchNumber << " is a prerequisite for:" << endl;
+        for (const auto& dep : dependentCourses) {
+            cout << "  - " << dep << endl;
+        }
+        cout << endl;
+        cout << "Removing this course will affect these courses." << endl;
+        cout << "Are you sure you want to continue? (yes/no): ";
+        
+        string confirmation;
+        getline(cin, confirmation);
+        
+        if (toUpperCase(trim(confirmation)) != "YES") {
+            cout << "Course removal cancelled." << endl;
+            return;
+        }
+    }
+    
+    // Remove the course
+    bool removed = removeCourseRecord(hashTable, searchNumber, journal);
+    
+    // End timing
+    auto endTime = high_resolution_clock::now();
+    clock_t endTicks = clock();
+    
+    // Calculate elapsed time
+    auto duration = duration_cast<microseconds>(endTime - startTime);
+    double seconds = duration.count() / 1000000.0;
+    clock_t ticks = endTicks - startTicks;
+    
+    if (removed) {
+        cout << endl;
+        cout << "Course " << searchNumber << " removed successfully." << endl;
+        cout << "WARNING: All prerequisites referencing this course will be automatically removed from other courses." << endl;
+        cout << "Do you want to proceed with prerequisite cleanup? (yes/no): ";
+        string cleanupConfirm;
+        getline(cin, cleanupConfirm);
+        if (toUpperCase(trim(cleanupConfirm)) == "YES") {
+            removePrerequisiteFromAllCourses(hashTable, searchNumber, journal);
+            cout << "Prerequisite cleanup completed." << endl;
+        } else {
+            cout << "Prerequisite cleanup skipped. Some courses may still reference this course as a prerequisite." << endl;
+        }
+        cout << "Time to remove: " << ticks << " clock ticks" << endl;
+        cout << "Time to remove: " << fixed << setprecision(6) << seconds << " seconds" << endl;
+    } else {
+        cout << "Error: Failed to remove course." << endl;
+    }
+}
+/**
+ * Build the read-only perfect hash index for the loaded catalog
+ * @param hashTable Reference to the hash table containing courses
+ * @param out Stream for status and timing output
+ * @return True if the catalog is frozen
+ */
+bool freezeCatalog(HashTable& hashTable, ostream& out = cout) {
+    if (hashTable.size() == 0) {
+        out << "No courses loaded. Please load data first (Option 1)." << endl;
+        return false;
+    }
+
+    // Start timing
+    auto startTime = high_resolution_clock::now();
+    clock_t startTicks = clock();
+
+    unsigned int threadCount = max(1u, thread::hardware_concurrency());
+    if (!hashTable.freeze(threadCount)) {
+        out << "Error: Could not build the frozen index (duplicate course numbers?)." << endl;
+        return false;
+    }
+
+    // End timing
+    auto endTime = high_resolution_clock::now();
+    clock_t endTicks = clock();
+
+    // Calculate elapsed time
+    auto duration = duration_cast<microseconds>(endTime - startTime);
+    double seconds = duration.count() / 1000000.0;
+    clock_t ticks = endTicks - startTicks;
+
+    const FrozenCourseIndex& index = hashTable.frozenIndex();
+    out << index.size() << " courses frozen into a perfect hash index (" << index.partitionCount()
+        << " partitions, " << min<size_t>(threadCount, index.partitionCount()) << " threads)." << endl;
+    out << "Lookups now take a single probe; the next add, remove or edit switches back to the regular table." << endl;
+    out << "Time to freeze: " << ticks << " clock ticks" << endl;
+    out << "Time to freeze: " << fixed << setprecision(6) << seconds << " seconds" << endl;
+    return true;
+}
+
+//=============================================================================
+// Catalog Statistics
+//=============================================================================
+
+/**
+ * Print the hash table's bucket occupancy, chain lengths and memory use,
+ * next to what a uniformly random hash would give for the same sizes
+ * @param hashTable Reference to the hash table containing courses
+ * @param out Stream for the report
+ * @return True if any courses are loaded
+ */
+bool printCatalogStats(const HashTable& hashTable, ostream& out = cout) {
+    if (hashTable.size() == 0) {
+        out << "No courses loaded. Please load data first (Option 1)." << endl;
+        return false;
+    }
+    HashTableStats stats = hashTable.stats();
+    const double courses = static_cast<double>(stats.courseCount);
+    const double buckets = static_cast<double>(stats.bucketCount);
+
+    // A uniform hash leaves each bucket empty with probability (1 - 1/m)^n
+    double expectedUsed = buckets * -expm1(courses * log1p(-1.0 / buckets));
+
+    out << fixed << setprecision(2);
+    out << "Courses: " << stats.courseCount << ", buckets: " << stats.bucketCount
+        << ", load factor: " << courses / buckets << endl;
+    out << "Buckets used: " << stats.usedBuckets << " (" << 100.0 * stats.usedBuckets / buckets
+        << "%), uniform hash: " << static_cast<size_t>(expectedUsed + 0.5) << endl;
+    out << "Collisions: " << stats.collisions << " courses share a bucket, uniform hash: "
+        << static_cast<size_t>(courses - expectedUsed + 0.5) << endl;
+    out << "Longest chain: " << stats.longestChain << endl;
+    out << "Chain lengths:" << endl;
+    for (size_t length = 0; length < stats.chainLengths.size(); ++length) {
+        bool last = length + 1 == stats.chainLengths.size();
+        out << "  " << setw(2) << length << (last ? "+" : " ") << " " << setw(10) << stats.chainLengths[length]
+            << " buckets (" << setw(6) << 100.0 * stats.chainLengths[length] / buckets << "%)" << endl;
+    }
+
+    size_t courseBytes = stats.nodeBytes + stats.stringBytes + stats.prerequisiteBytes;
+    auto line = [&out, courses](const char* label, size_t bytes) {
+        out << "  " << left << setw(16) << label << right << setw(12) << bytes << " bytes, "
+            << setw(8) << bytes / courses << " per course" << endl;
+    };
+    out << "Memory:" << endl;
+    line("Nodes", stats.nodeBytes);
+    line("Strings", stats.stringBytes);
+    line("Prerequisites", stats.prerequisiteBytes);
+    line("Bucket array", stats.bucketBytes);
+    line("Total", courseBytes + stats.bucketBytes);
+    out << "  Heap blocks: " << stats.heapBlocks << " (" << stats.heapBlocks / courses << " per course)" << endl;
+#ifdef COURSE_COUNT_ALLOCATIONS
+    out << "  Heap allocations since start: " << heapAllocations() << endl;
+#endif
+
+    const LookupFilterStats& filterStats = hashTable.lookupFilterStats();
+    out << "Lookup filter: " << hashTable.lookupFilter().bytes() << " bytes, " << filterStats.rejected
+        << " misses rejected, " << filterStats.passedFound << " hits passed, " << filterStats.falsePositives
+        << " false positives" << endl;
+    const CourseDetailCache& cache = hashTable.renderedDetails();
+    out << "Detail cache: " << cache.size() << " of " << cache.capacity() << " entries, " << cache.hits()
+        << " hits, " << cache.misses() << " misses" << endl;
+    if (stats.columnBytes != 0) {
+        out << "Columnar copy: " << stats.columnBytes << " bytes" << endl;
+    }
+    if (stats.mappedBytes != 0) {
+        out << "Lazily loaded titles: " << stats.mappedBytes << " bytes of mapped catalog files" << endl;
+    }
+    if (stats.departmentBytes != 0) {
+        out << "Department index: " << stats.departmentCount << " departments, " << stats.departmentBytes << " bytes" << endl;
+    }
+    if (hashTable.isFrozen()) {
+        out << "Frozen index: " << hashTable.frozenIndex().size() << " courses" << endl;
+    }
+    out << defaultfloat;
+    return true;
+}
+
+//=============================================================================
+// Course Eligibility
+//=============================================================================
+
+/**
+ * Turn a comma-separated list of completed courses into column store key ids
+ * @param hashTable Reference to the hash table containing courses
+ * @param completedInput Comma-separated course numbers ("" or "none" for none)
+ * @param notInCatalog Receives the listed course numbers the catalog does not hold
+ * @return Key ids of the completed courses (NO_KEY for ones no course refers to)
+ */
+vector<uint32_t> parseTranscript(HashTable& hashTable, const string& completedInput, vector<string>& notInCatalog) {
+    const CourseColumns& columns = hashTable.columns();
+    vector<uint32_t> completedKeyIds;
+    string normalizedInput = toUpperCase(trim(completedInput));
+    if (normalizedInput.empty() || normalizedInput == "NONE") {
+        return completedKeyIds;
+    }
+    for (const auto& courseNumber : split(normalizedInput, ',')) {
+        if (courseNumber.empty()) {
+            continue;
+        }
+        // A retired course still counts when other courses list it
+        if (hashTable.find(courseNumber) == nullptr) {
+            notInCatalog.push_back(courseNumber);
+        }
+        completedKeyIds.push_back(columns.keyId(courseNumber));
+    }
+    return completedKeyIds;
+}
+
+/**
+ * Print every course a student can take next: all of its prerequisites
+ * are completed and the course itself is not
+ * @param hashTable Reference to the hash table containing courses
+ * @param completedInput Comma-separated completed course numbers ("" or "none" for none)
+ * @param out Stream for the listing and timing output
+ * @return True if the check ran, false if no courses are loaded
+ */
+bool printEligibleCourses(HashTable& hashTable, const string& completedInput, ostream& out = cout) {
+    if (hashTable.size() == 0) {
+        out << "No courses loaded. Please load data first (Option 1)." << endl;
+        return false;
+    }
+
+    // Start timing
+    auto startTime = high_resolution_clock::now();
+    clock_t startTicks = clock();
+
+    vector<string> notInCatalog;
+    vector<uint32_t> completedKeyIds = parseTranscript(hashTable, completedInput, notInCatalog);
+    const EligibilityMatrix& matrix = hashTable.eligibility();
+    const CourseColumns& columns = hashTable.columns();
+    vector<uint32_t> eligible;
+    vector<uint64_t> scratch;
+    matrix.eligibleRows(matrix.transcriptBits(completedKeyIds), eligible, scratch);
+
+    for (const auto& courseNumber : notInCatalog) {
+        out << "Note: " << courseNumber << " is not in the catalog." << endl;
+    }
+    out << eligible.size() << " eligible courses:" << endl;
+    for (uint32_t row : eligible) {
+        out << columns.key(row) << ", " << columns.title(row) << '\n';
+    }
+
+    // End timing
+    auto endTime = high_resolution_clock::now();
+    clock_t endTicks = clock();
+
+    // Calculate elapsed time
+    auto duration = duration_cast<microseconds>(endTime - startTime);
+    double seconds = duration.count() / 1000000.0;
+    clock_t ticks = endTicks - startTicks;
+
+    out << "Time to check: " << ticks << " clock ticks" << endl;
+    out << "Time to check: " << fixed << setprecision(6) << seconds << " seconds" << endl;
+    return true;
+}
+
+/**
+ * Prompt for a transcript and print the courses it makes eligible
+ * @param hashTable Reference to the hash table containing courses
+ */
+void checkEligibility(HashTable& hashTable) {
+    cout << "Enter completed courses (comma-separated, leave blank if none): ";
+    string completedInput;
+    getline(cin, completedInput);
+    printEligibleCourses(hashTable, completedInput);
+}
+
+//=============================================================================
+// Prerequisite Chain Report
+//=============================================================================
+
+// Critical-path courses listed by the summary before it abbreviates
+const size_t CHAIN_REPORT_LIMIT = 20;
+
+// Join course numbers into "A -> B -> C"
+string formatChain(const vector<string>& chain) {
+    string text;
+    for (size_t i = 0; i < chain.size(); ++i) {
+        if (i > 0) {
+            text += " -> ";
+        }
+        text += chain[i];
+    }
+    return text;
+}
+
+/**
+ * Print the longest prerequisite chains: for one course, its earliest
+ * term, the longest chain it starts and one longest chain through it;
+ * for the whole catalog, the longest chain, courses per earliest term and
+ * the courses on a critical path
+ * @param hashTable Reference to the hash table containing courses
+ * @param courseNumber The course to report on, or "" for the whole catalog
+ * @param out Stream for the report
+ * @return True if the report was printed
+ */
+bool printPrerequisiteChains(HashTable& hashTable, const string& courseNumber, ostream& out = cout) {
+    if (hashTable.size() == 0) {
+        out << "No courses loaded. Please load data first (Option 1)." << endl;
+        return false;
+    }
+    auto startTime = high_resolution_clock::now();
+    const PrerequisiteChains& chains = hashTable.prerequisiteChains(max(1u, thread::hardware_concurrency()));
+    auto duration = duration_cast<microseconds>(high_resolution_clock::now() - startTime);
+
+    string searchNumber = toUpperCase(trim(courseNumber));
+    if (!searchNumber.empty()) {
+        PrerequisiteChains::CourseChain chain;
+        if (!chains.find(searchNumber, chain)) {
+            out << "Error: Course '" << trim(courseNumber) << "' not found. Please enter a valid course number." << endl;
+            return false;
+        }
+        if (chain.depth == 0) {
+            out << searchNumber << " is in or behind a prerequisite cycle, so it can never be taken." << endl;
+            return true;
+        }
+        out << searchNumber << ": earliest term " << chain.depth << ", longest chain from it " << chain.height
+            << (chain.height == 1 ? " course" : " courses") << (chain.critical ? ", on a critical path" : "") << endl;
+        out << "Longest chain through " << searchNumber << ": " << formatChain(chains.longestChainThrough(searchNumber)) << endl;
+        return true;
+    }
+
+    const vector<size_t>& coursesByDepth = chains.coursesByDepth();
+    out << "Longest prerequisite chain: " << chains.longestChain() << (chains.longestChain() == 1 ? " term" : " terms") << endl;
+    if (chains.longestChain() != 0) {
+        out << "  " << formatChain(chains.longestChainThrough("")) << endl;
+    }
+    out << "Courses by earliest term:" << endl;
+    for (size_t term = 1; term < coursesByDepth.size(); ++term) {
+        out << "  Term " << setw(3) << term << ": " << coursesByDepth[term] << endl;
+    }
+    vector<string> critical = chains.criticalCourses();
+    out << "Courses on a critical path: " << critical.size() << endl;
+    for (size_t i = 0; i < critical.size() && i < CHAIN_REPORT_LIMIT; ++i) {
+        PrerequisiteChains::CourseChain chain;
+        chains.find(critical[i], chain);
+        out << "  " << critical[i] << " (term " << chain.depth << ")" << endl;
+    }
+    if (critical.size() > CHAIN_REPORT_LIMIT) {
+        out << "  ... and " << critical.size() - CHAIN_REPORT_LIMIT << " more" << endl;
+    }
+    if (coursesByDepth[0] != 0) {
+        out << "Warning: " << coursesByDepth[0]
+            << " courses are in or behind a prerequisite cycle and can never be taken." << endl;
+    }
+    out << "Courses recomputed: " << chains.lastUpdateSize() << endl;
+    out << "Time to compute: " << fixed << setprecision(6) << duration.count() / 1000000.0 << " seconds" << endl;
+    return true;
+}
+
+/**
+ * Ask for a course and print its prerequisite chains, or the catalog's
+ * @param hashTable Reference to the hash table containing courses
+ */
+void showPrerequisiteChains(HashTable& hashTable) {
+    cout << "Enter a course number (leave blank for the whole catalog): ";
+    string courseNumber;
+    getline(cin, courseNumber);
+    printPrerequisiteChains(hashTable, courseNumber);
+}
+
+//=============================================================================
+// Catalog Export
+//=============================================================================
+
+// Output formats for exportCourseData
+enum class ExportFormat {
+    Csv,       // Same layout as the input files: number,title,prereq,...
+    JsonLines  // One JSON object per course per line
+};
+
+/**
+ * Buffered file writer for bulk export
+ * Records are appended to one large reusable buffer that is handed to the
+ * OS a megabyte at a time, so writing millions of small records costs one
+ * system call per megabyte and no per-record allocation
+ */
+class BufferedFileWriter {
+public:
+    explicit BufferedFileWriter(size_t capacity = 1 << 20) : buffer(capacity) {}
+
+    ~BufferedFileWriter() {
+        discard();
+    }
+
+    /**
+     * Open the output file. Output goes to a temporary file next to it that
+     * replaces the target on close(), so a reader that has the old file
+     * mapped (lazy titles) keeps its inode instead of seeing it truncated
+     * @param filename Path of the file to write
+     * @return True if the file was opened
+     */
+    bool open(const string& filename) {
+        target = filename;
+        tempPath = filename + ".tmp";
+        file = fopen(tempPath.c_str(), "wb");
+        if (file != nullptr) {
+            // Our buffer replaces stdio's, avoiding a second copy
+            setvbuf(file, nullptr, _IONBF, 0);
+        }
+        return file != nullptr;
+    }
+
+    void append(const char* data, size_t length) {
+        if (used + length > buffer.size()) {
+            flush();
+            if (length > buffer.size()) {
+                writeThrough(data, length);
+                return;
+            }
+        }
+        memcpy(buffer.data() + used, data, length);
+        used += length;
+    }
+
+    void append(string_view text) {
+        append(text.data(), text.size());
+    }
+
+    void append(char ch) {
+        if (used == buffer.size()) {
+            flush();
+        }
+        buffer[used++] = ch;
+    }
+
+    /**
+     * Flush remaining output, sync it, and move the file over the target;
+     * the rename is synced too, so a true return means the output survives
+     * a crash (a snapshot export relies on this before clearing its journal)
+     * @return False if the output is not complete and durable; a write
+     * that failed before the rename leaves the target untouched
+     */
+    bool close() {
+        if (file == nullptr) {
+            return !failed;
+        }
+        flush();
+        failed |= !syncFile(file);
+        failed |= fclose(file) != 0;
+        file = nullptr;
+        if (!failed) {
+            error_code error;
+            filesystem::rename(tempPath, target, error);
+            failed = error || !syncParentDirectory(target);
+        }
+        if (failed) {
+            error_code ignored;
+            filesystem::remove(tempPath, ignored);
+        }
+        return !failed;
+    }
+
+    size_t bytesWritten() const {
+        return written + used;
+    }
+
+private:
+    void flush() {
+        writeThrough(buffer.data(), used);
+        used = 0;
+    }
+
+    void writeThrough(const char* data, size_t length) {
+        if (length > 0 && fwrite(data, 1, length, file) != length) {
+            failed = true;
+        }
+        written += length;
+    }
+
+    // A writer that is never closed leaves the target as it was
+    void discard() {
+        if (file != nullptr) {
+            fclose(file);
+            file = nullptr;
+            error_code ignored;
+            filesystem::remove(tempPath, ignored);
+        }
+    }
+
+    vector<char> buffer;
+    string target;
+    string tempPath;
+    FILE* file = nullptr;
+    size_t used = 0;
+    size_t written = 0;
+    bool failed = false;
+};
+
+/**
+ * Check a file name's extension, ignoring case
+ * @param filename The file name
+ * @param suffix The lowercase extension, with its dot
+ * @return True if the name ends with the extension
+ */
+bool fileNameEndsWith(const string& filename, const string& suffix) {
+    string lower = filename;
+    transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    return lower.size() >= suffix.size() && lower.compare(lower.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+/**
+ * Choose the export format from a file name: .jsonl/.json is JSON Lines,
+ * anything else is CSV
+ * @param filename The output file name
+ * @return The export format
+ */
+ExportFormat exportFormatForFile(const string& filename) {
+    return fileNameEndsWith(filename, ".jsonl") || fileNameEndsWith(filename, ".json") ? ExportFormat::JsonLines : ExportFormat::Csv;
+}
+
+/**
+ * Exports are written uncompressed, so a .gz or .zst name would hold
+ * plain text that does not load back as what it claims to be
+ * @param filename The output file name
+ * @param out Stream for the error message
+ * @return True if the catalog may be exported under this name
+ */
+bool checkExportFileName(const string& filename, ostream& out) {
+    if (fileNameEndsWith(filename, ".gz") || fileNameEndsWith(filename, ".zst")) {
+        out << "Error: Exports are not compressed; choose a name without .gz or .zst ('" << filename << "')." << endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Append a JSON string literal, escaping quotes, backslashes and control characters
+ * @param writer The output writer
+ * @param text The string to encode
+ */
+void appendJsonString(BufferedFileWriter& writer, string_view text) {
+    static const char hexDigits[] = "0123456789abcdef";
+    writer.append('"');
+    size_t runStart = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        unsigned char ch = static_cast<unsigned char>(text[i]);
+        if (ch != '"' && ch != '\\' && ch >= 0x20) {
+            continue;
+        }
+        writer.append(text.data() + runStart, i - runStart);
+        runStart = i + 1;
+        if (ch == '"' || ch == '\\') {
+            writer.append('\\');
+            writer.append(static_cast<char>(ch));
+        } else {
+            char escape[6] = {'\\', 'u', '0', '0', hexDigits[ch >> 4], hexDigits[ch & 0xF]};
+            writer.append(escape, sizeof(escape));
+        }
+    }
+    writer.append(text.data() + runStart, text.size() - runStart);
+    writer.append('"');
+}
+
+/**
+ * Append one course record in the requested format
+ * @param writer The output writer
+ * @param course The course to write
+ * @param format CSV (input layout) or JSON Lines
+ */
+void writeCourseRecord(BufferedFileWriter& writer, const Course& course, ExportFormat format) {
+    if (format == ExportFormat::Csv) {
+        writer.append(course.courseNumber);
+        writer.append(',');
+        writer.append(course.title());
+        for (const auto& prereq : course.prerequisites) {
+            writer.append(',');
+            writer.append(prereq);
+        }
+        writer.append('\n');
+        return;
+    }
+
+    writer.append("{\"courseNumber\":", 16);
+    appendJsonString(writer, course.courseNumber);
+    writer.append(",\"courseTitle\":", 15);
+    appendJsonString(writer, course.title());
+    writer.append(",\"prerequisites\":[", 18);
+    for (size_t i = 0; i < course.prerequisites.size(); ++i) {
+        if (i > 0) {
+            writer.append(',');
+        }
+        appendJsonString(writer, course.prerequisites[i]);
+    }
+    writer.append("]}\n", 3);
+}
+
+/**
+ * Collect pointers to every course in alphanumeric order, without copying courses
+ * @param hashTable Reference to the hash table containing courses
+ * @return Course pointers sorted by course number (same order as printCourseList)
+ */
+vector<const Course*> sortedCoursePointers(const HashTable& hashTable) {
+    vector<const Course*> courses;
+    courses.reserve(hashTable.size());
+    hashTable.forEachCourse([&courses](const Course& course) { courses.push_back(&course); });
+    sortByCourseNumber(courses, [](const Course* course) { return string_view(course->courseNumber); },
+                       max(1u, thread::hardware_concurrency()));
+    return courses;
+}
+
+/**
+ * Write the live catalog to a file, streaming straight from the hash table
+ * @param hashTable Reference to the hash table containing courses
+ * @param filename Path of the file to write
+ * @param format CSV (input layout, reloadable with option 1) or JSON Lines
+ * @param sorted True to write in course-number order, false for table order
+ * @param out Stream for status, timing and error messages
+ * @return True if the export succeeded
+ */
+bool exportCourseData(const HashTable& hashTable, const string& filename, ExportFormat format, bool sorted, ostream& out = cout) {
+    // Start timing
+    auto startTime = high_resolution_clock::now();
+    clock_t startTicks = clock();
+
+    if (hashTable.size() == 0) {
+        out << "No courses loaded. Please load data first (Option 1)." << endl;
+        return false;
+    }
+
+    BufferedFileWriter writer;
+    if (!writer.open(filename)) {
+        out << "Error: Could not open file '" << filename << "' for writing" << endl;
+        return false;
+    }
+
+    // The input format has no quoting, so a comma in a title cannot round-trip
+    size_t titlesWithCommas = 0;
+    auto writeCourse = [&](const Course& course) {
+        if (format == ExportFormat::Csv && course.title().find(',') != string::npos) {
+            ++titlesWithCommas;
+        }
+        writeCourseRecord(writer, course, format);
+    };
+
+    if (sorted) {
+        for (const Course* course : sortedCoursePointers(hashTable)) {
+            writeCourse(*course);
+        }
+    } else {
+        hashTable.forEachCourse(writeCourse);
+    }
+
+    size_t bytes = writer.bytesWritten();
+    if (!writer.close()) {
+        out << "Error: Failed while writing '" << filename << "'" << endl;
+        return false;
+    }
+
+    // End timing
+    auto endTime = high_resolution_clock::now();
+    clock_t endTicks = clock();
+
+    // Calculate elapsed time
+    auto duration = duration_cast<microseconds>(endTime - startTime);
+    double seconds = duration.count() / 1000000.0;
+    clock_t ticks = endTicks - startTicks;
+
+    out << hashTable.size() << " courses exported to " << filename << " (" << bytes << " bytes, "
+        << (format == ExportFormat::Csv ? "CSV" : "JSON Lines") << ")." << endl;
+    if (titlesWithCommas > 0) {
+        out << "WARNING: " << titlesWithCommas << " course titles contain commas and will not reload correctly from CSV." << endl;
+    }
+    out << "Time to export: " << ticks << " clock ticks" << endl;
+    out << "Time to export: " << fixed << setprecision(6) << seconds << " seconds" << endl;
+    return true;
+}
+
+/**
+ * Export the catalog to a file chosen by the user
+ * @param hashTable Reference to the hash table containing courses
+ * @param journal Journal to clear when the export overwrites its base file, or nullptr
+ */
+void exportCourses(HashTable& hashTable, CourseJournal* journal = nullptr) {
+    string filename;
+    cout << "Enter output file name (.csv for the input format, .jsonl for JSON Lines): ";
+    getline(cin, filename);
+    filename = trim(filename);
+    if (filename.empty()) {
+        cout << "Error: File name cannot be empty." << endl;
+        return;
+    }
+    if (!checkExportFileName(filename, cout)) {
+        return;
+    }
+
+    cout << "Sort by course number? (yes/no): ";
+    string sortAnswer;
+    getline(cin, sortAnswer);
+
+    if (exportCourseData(hashTable, filename, exportFormatForFile(filename), toUpperCase(trim(sortAnswer)) == "YES") &&
+        journal != nullptr) {
+        journal->snapshotSaved(filename, cout);
+    }
+}
+
+//=============================================================================
+// Synthetic Catalog Generation
+//=============================================================================
+
+/**
+ * Write a synthetic catalog in the input CSV format for load testing
+ * Every prerequisite refers to an earlier course, so the file always loads
+ * @param courseCount Number of courses to generate
+ * @param filename Path of the CSV file to write
+ * @return True if the file was written, false otherwise
+ */
+bool generateSyntheticCatalog(size_t courseCount, const string& filename) {
+    static const char* departments[] = {"CSCI", "MATH", "PHYS", "CHEM", "BIOL", "ENGL", "HIST", "ECON"};
+    static const char* subjects[] = {"Algorithms", "Systems", "Theory", "Analysis", "Design", "Methods", "Foundations", "Topics"};
+    const size_t departmentCount = sizeof(departments) / sizeof(departments[0]);
+
+    ofstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Error: Could not open file '" << filename << "' for writing" << endl;
+        return false;
+    }
+
+    // Fixed seed so that the same count always produces the same catalog
+    mt19937 generator(300);
+    vector<string> courseNumbers;
+    courseNumbers.reserve(courseCount);
+
+    for (size_t i = 0; i < courseCount; ++i) {
+        string courseNumber = string(departments[i % departmentCount]) + to_string(100 + i / departmentCount);
+        file << courseNumber << ",Synthetic " << subjects[generator() % 8] << " " << i;
+
+        // Up to three distinct prerequisites drawn from the courses already
+        // written; a repeated draw is redrawn (prereqCount <= i, so one exists)
+        size_t prereqCount = i == 0 ? 0 : min<size_t>(generator() % 4, i);
+        size_t chosen[3];
+        for (size_t p = 0; p < prereqCount; ++p) {
+            do {
+                chosen[p] = generator() % i;
+            } while (find(chosen, chosen + p, chosen[p]) != chosen + p);
+            file << "," << courseNumbers[chosen[p]];
+        }
+        file << "\n";
+        courseNumbers.push_back(courseNumber);
+    }
+
+    cout << courseCount << " synthetic courses written to " << filename << endl;
+    return true;
+}
+
+//=============================================================================
+// Embedded Catalog Header
+//=============================================================================
+
+/**
+ * Append text as a C++ string literal body, escaping what the compiler would misread
+ * @param header The header text being built
+ * @param text The raw text
+ */
+void appendCppStringLiteral(string& header, string_view text) {
+    header += '"';
+    for (char ch : text) {
+        unsigned char byte = static_cast<unsigned char>(ch);
+        if (ch == '"' || ch == '\\') {
+            header += '\\';
+            header += ch;
+        } else if (byte < 0x20 || byte == 0x7F) {
+            // Three-digit octal escapes cannot swallow the characters after them
+            char escape[5];
+            snprintf(escape, sizeof(escape), "\\%03o", byte);
+            header += escape;
+        } else {
+            header += ch;
+        }
+    }
+    header += '"';
+}
+
+/**
+ * Write the catalog as a header for CourseManagement_minimal.cpp's
+ * EMBEDDED_CATALOG build: a constexpr course array sorted by course number
+ * and a flat array of prerequisite numbers. The perfect hash over these is
+ * computed by the compiler when the minimal program is built.
+ * @param hashTable The loaded (and therefore validated) catalog
+ * @param sourceName The CSV the catalog came from, recorded in the header
+ * @param filename Path of the header to write
+ * @return True if the header was written, false otherwise
+ */
+bool writeEmbeddedCatalogHeader(const HashTable& hashTable, const string& sourceName, const string& filename) {
+    if (hashTable.size() == 0) {
+        cerr << "Error: The catalog is empty; there is nothing to embed." << endl;
+        return false;
+    }
+
+    vector<const Course*> courses = sortedCoursePointers(hashTable);
+    size_t prerequisiteCount = 0;
+    for (const Course* course : courses) {
+        prerequisiteCount += course->prerequisites.size();
+    }
+
+    string header;
+    header += "// Generated by CourseManagement --embed from " + sourceName + ". Do not edit.\n";
+    header += "// Included by CourseManagement_minimal.cpp when built with -DEMBEDDED_CATALOG.\n\n";
+    header += "inline constexpr std::array<EmbeddedCourse, " + to_string(courses.size()) + "> EMBEDDED_COURSES{{\n";
+    size_t firstPrerequisite = 0;
+    for (const Course* course : courses) {
+        header += "    {";
+        appendCppStringLiteral(header, course->courseNumber);
+        header += ", ";
+        appendCppStringLiteral(header, course->title());
+        header += ", " + to_string(firstPrerequisite) + ", " + to_string(course->prerequisites.size()) + "},\n";
+        firstPrerequisite += course->prerequisites.size();
+    }
+    header += "}};\n\n";
+
+    header += "inline constexpr std::array<std::string_view, " + to_string(prerequisiteCount) + "> EMBEDDED_PREREQUISITES{{\n";
+    for (const Course* course : courses) {
+        for (const auto& prereq : course->prerequisites) {
+            header += "    ";
+            appendCppStringLiteral(header, prereq);
+            header += ",\n";
+        }
+    }
+    header += "}};\n";
+
+    ofstream file(filename, ios::binary | ios::trunc);
+    if (!file.is_open()) {
+        cerr << "Error: Could not open file '" << filename << "' for writing" << endl;
+        return false;
+    }
+    file << header;
+    if (!file) {
+        cerr << "Error: Failed while writing '" << filename << "'" << endl;
+        return false;
+    }
+
+    cout << courses.size() << " courses written to " << filename << endl;
+    return true;
+}
+
+//=============================================================================
+// Shared Catalog Segment (POSIX shared memory)
+//=============================================================================
+
+// Default shared-memory name used by --publish, --attach and --unpublish
+const string DEFAULT_SHARED_CATALOG_NAME = "/abcu_catalog";
+
+#ifndef _WIN32
+
+const uint32_t SHARED_CATALOG_MAGIC = 0x53434241; // "ABCS"
+// Bump when any of the structs below change layout
+const uint32_t SHARED_CATALOG_VERSION = 1;
+// Empty bucket / end of a bucket chain
+const uint32_t SHARED_CATALOG_NONE = UINT32_MAX;
+
+// A string in a shared catalog segment: a byte range of its string pool
+struct SharedCatalogString {
+    uint64_t offset;
+    uint32_t length;
+    uint32_t reserved;
+};
+
+// One course in a shared catalog segment. Everything is an offset or an
+// index, so the segment can be mapped at any address in any process.
+struct SharedCourseRecord {
+    SharedCatalogString number;
+    SharedCatalogString title;
+    uint32_t firstPrerequisite; // Index into the prerequisite array
+    uint32_t prerequisiteCount;
+    uint32_t nextInBucket; // Record index, or SHARED_CATALOG_NONE
+    uint32_t reserved;
+};
+
+// Start of a shared catalog segment. The arrays follow in this order, each
+// 8-byte aligned, at the offsets recorded here.
+struct SharedCatalogHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t generation;
+    uint64_t totalBytes;
+    uint32_t courseCount;
+    uint32_t bucketCount;
+    uint64_t bucketsOffset; // uint32_t[bucketCount]: first record index in each bucket
+    uint64_t recordsOffset; // SharedCourseRecord[courseCount], sorted by course number
+    uint64_t prerequisitesOffset; // SharedCatalogString[], grouped by course
+    uint64_t stringsOffset; // String pool
+};
+
+// The control block under the catalog's own name. It holds only the
+// generation readers should be on; each generation's catalog lives in its
+// own segment, "<name>.<generation>".
+struct SharedCatalogControl {
+    uint32_t magic;
+    uint32_t version;
+    atomic<uint64_t> generation; // 0 until the first publish
+};
+
+// The generation is read and written from several processes at once
+static_assert(atomic<uint64_t>::is_always_lock_free, "shared catalogs need a lock-free 64-bit atomic");
+
+/**
+ * Normalize a shared-memory name to the "/name" form shm_open expects
+ * @param name The name given on the command line
+ * @param normalized Set to the name with a leading slash
+ * @return False if the name is empty or contains another slash
+ */
+bool normalizeSharedCatalogName(const string& name, string& normalized) {
+    normalized = (!name.empty() && name[0] == '/') ? name : "/" + name;
+    return normalized.size() > 1 && normalized.find('/', 1) == string::npos;
+}
+
+// Name of the segment holding one generation of a catalog
+string sharedCatalogSegmentName(const string& name, uint64_t generation) {
+    return name + "." + to_string(generation);
+}
+
+/**
+ * Map a shared-memory object
+ * @param name The object's name
+ * @param writable True to open read-write (creating it with createSize bytes if
+ *                 createSize is nonzero), false to map it read-only
+ * @param length In: the size to create with; out: the mapped size
+ * @param exclusive True to fail if the object already exists
+ * @return The mapping, or nullptr with errno set
+ */
+void* mapSharedObject(const string& name, bool writable, size_t& length, bool exclusive = false) {
+    int flags = writable ? O_RDWR : O_RDONLY;
+    if (writable && length > 0) {
+        flags |= O_CREAT | (exclusive ? O_EXCL : 0);
+    }
+    int descriptor = shm_open(name.c_str(), flags, 0644);
+    if (descriptor < 0) {
+        return nullptr;
+    }
+    struct stat info;
+    if (writable && length > 0 && ftruncate(descriptor, static_cast<off_t>(length)) != 0) {
+        int error = errno;
+        ::close(descriptor);
+        errno = error;
+        return nullptr;
+    }
+    if (fstat(descriptor, &info) != 0) {
+        int error = errno;
+        ::close(descriptor);
+        errno = error;
+        return nullptr;
+    }
+    if (info.st_size <= 0) {
+        // Created but not yet sized by its publisher
+        ::close(descriptor);
+        errno = EINVAL;
+        return nullptr;
+    }
+    length = static_cast<size_t>(info.st_size);
+    void* address = mmap(nullptr, length, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, descriptor, 0);
+    int error = errno;
+    // The mapping stays valid after the descriptor is closed
+    ::close(descriptor);
+    errno = error;
+    return address == MAP_FAILED ? nullptr : address;
+}
+
+/**
+ * A read-only view of a published catalog. Attaching maps the current
+ * generation's segment; nothing is copied or parsed, so it takes about as
+ * long as the shm_open and mmap calls. A view stays on its generation
+ * (the segment outlives a republish while it is mapped) until refresh()
+ * moves it to the newest one.
+ */
+class SharedCatalogView {
+public:
+    SharedCatalogView() = default;
+    SharedCatalogView(const SharedCatalogView&) = delete;
+    SharedCatalogView& operator=(const SharedCatalogView&) = delete;
+
+    ~SharedCatalogView() {
+        unmapSegment();
+        if (control != nullptr) {
+            munmap(const_cast<SharedCatalogControl*>(control), sizeof(SharedCatalogControl));
+        }
+    }
+
+    /**
+     * Attach to the newest generation of a published catalog
+     * @param catalogName The shared-memory name it was published under
+     * @param error Set to the reason on failure
+     * @return False if nothing usable is published under the name
+     */
+    bool attach(const string& catalogName, string& error) {
+        if (control == nullptr) {
+            size_t length = 0;
+            void* address = mapSharedObject(catalogName, false, length);
+            if (address == nullptr) {
+                error = errno == ENOENT ? "no catalog has been published as " + catalogName
+                                        : "could not open " + catalogName + ": " + strerror(errno);
+                return false;
+            }
+            if (length < sizeof(SharedCatalogControl)) {
+                munmap(address, length);
+                error = catalogName + " is not a shared course catalog";
+                return false;
+            }
+            control = static_cast<const SharedCatalogControl*>(address);
+            name = catalogName;
+        }
+        if (control->magic != SHARED_CATALOG_MAGIC || control->version != SHARED_CATALOG_VERSION) {
+            error = name + " was published by an incompatible version of this program";
+            return false;
+        }
+        // A publish between reading the generation and opening its segment
+        // unlinks that segment; read the generation again and retry
+        for (int attempt = 0; attempt < 8; ++attempt) {
+            uint64_t current = control->generation.load(memory_order_acquire);
+            if (current == 0) {
+                error = "no catalog has been published as " + name;
+                return false;
+            }
+            size_t length = 0;
+            void* address = mapSharedObject(sharedCatalogSegmentName(name, current), false, length);
+            if (address == nullptr) {
+                if (errno == ENOENT) {
+                    continue;
+                }
+                error = "could not open " + sharedCatalogSegmentName(name, current) + ": " + strerror(errno);
+                return false;
+            }
+            if (!segmentIsValid(static_cast<const char*>(address), length, current)) {
+                munmap(address, length);
+                error = sharedCatalogSegmentName(name, current) + " is damaged or from an incompatible version";
+                return false;
+            }
+            unmapSegment();
+            base = static_cast<const char*>(address);
+            segmentLength = length;
+            header = reinterpret_cast<const SharedCatalogHeader*>(base);
+            return true;
+        }
+        error = name + " is being republished too quickly to attach";
+        return false;
+    }
+
+    /**
+     * Move to the newest generation if one was published since attaching
+     * @param error Set to the reason if the newer generation could not be mapped
+     * @return True if the view now shows a newer generation
+     */
+    bool refresh(string& error) {
+        if (control == nullptr || control->generation.load(memory_order_acquire) == generation()) {
+            return false;
+        }
+        return attach(name, error);
+    }
+
+    uint64_t generation() const {
+        return header != nullptr ? header->generation : 0;
+    }
+
+    size_t size() const {
+        return header != nullptr ? header->courseCount : 0;
+    }
+
+    size_t bytes() const {
+        return segmentLength;
+    }
+
+    /**
+     * Find a course by its (uppercase) number
+     * @param courseNumber The course number to look up
+     * @return The course's record, or nullptr if it is not in the catalog
+     */
+    const SharedCourseRecord* find(string_view courseNumber) const {
+        if (header == nullptr) {
+            return nullptr;
+        }
+        uint32_t index = buckets()[reduceHash(courseKeyHash(courseNumber), header->bucketCount)];
+        while (index != SHARED_CATALOG_NONE) {
+            const SharedCourseRecord& record = records()[index];
+            if (text(record.number) == courseNumber) {
+                return &record;
+            }
+            index = record.nextInBucket;
+        }
+        return nullptr;
+    }
+
+    // Visit every record in course-number order
+    template <typename Visitor>
+    void forEachCourse(Visitor visit) const {
+        for (size_t i = 0; i < size(); ++i) {
+            visit(records()[i]);
+        }
+    }
+
+    string_view text(const SharedCatalogString& value) const {
+        return string_view(base + header->stringsOffset + value.offset, value.length);
+    }
+
+    /**
+     * Copy a record into a Course for the rendering code. The title stays a
+     * view into the segment, so the Course must not outlive this generation.
+     */
+    Course course(const SharedCourseRecord& record) const {
+        Course result;
+        result.courseNumber = string(text(record.number));
+        result.titleSource = text(record.title);
+        const SharedCatalogString* prerequisites =
+            reinterpret_cast<const SharedCatalogString*>(base + header->prerequisitesOffset);
+        result.prerequisites.reserve(record.prerequisiteCount);
+        for (uint32_t i = 0; i < record.prerequisiteCount; ++i) {
+            result.prerequisites.emplace_back(text(prerequisites[record.firstPrerequisite + i]));
+        }
+        return result;
+    }
+
+private:
+    string name;
+    const SharedCatalogControl* control = nullptr;
+    const char* base = nullptr;
+    size_t segmentLength = 0;
+    const SharedCatalogHeader* header = nullptr;
+
+    const uint32_t* buckets() const {
+        return reinterpret_cast<const uint32_t*>(base + header->bucketsOffset);
+    }
+
+    const SharedCourseRecord* records() const {
+        return reinterpret_cast<const SharedCourseRecord*>(base + header->recordsOffset);
+    }
+
+    void unmapSegment() {
+        if (base != nullptr) {
+            munmap(const_cast<char*>(base), segmentLength);
+            base = nullptr;
+            header = nullptr;
+            segmentLength = 0;
+        }
+    }
+
+    // Check that a segment's arrays lie inside it before trusting its offsets
+    static bool segmentIsValid(const char* address, size_t length, uint64_t expectedGeneration) {
+        if (length < sizeof(SharedCatalogHeader)) {
+            return false;
+        }
+        const SharedCatalogHeader* candidate = reinterpret_cast<const SharedCatalogHeader*>(address);
+        return candidate->magic == SHARED_CATALOG_MAGIC && candidate->version == SHARED_CATALOG_VERSION &&
+               candidate->generation == expectedGeneration && candidate->totalBytes == length &&
+               candidate->bucketCount > 0 &&
+               candidate->bucketsOffset + uint64_t(candidate->bucketCount) * sizeof(uint32_t) <= candidate->recordsOffset &&
+               candidate->recordsOffset + uint64_t(candidate->courseCount) * sizeof(SharedCourseRecord) <= candidate->prerequisitesOffset &&
+               candidate->prerequisitesOffset <= candidate->stringsOffset && candidate->stringsOffset <= length;
+    }
+};
+
+#endif
+
+/**
+ * Publish the catalog as a new generation of a shared catalog segment.
+ * The segment is written in full under "<name>.<generation>" before the
+ * control block's generation is bumped, so readers never see a partial
+ * catalog; the previous generation is then unlinked, and its memory is
+ * freed once the last reader still on it refreshes or exits. Publishers
+ * of the same name must take turns.
+ * @param hashTable The loaded catalog
+ * @param name The shared-memory name to publish under
+ * @param out Stream for the summary line
+ * @return True if the new generation is live
+ */
+bool publishSharedCatalog(const HashTable& hashTable, const string& name, ostream& out = cout) {
+#ifdef _WIN32
+    (void)hashTable;
+    (void)name;
+    (void)out;
+    cerr << "Error: Shared catalogs require POSIX shared memory." << endl;
+    return false;
+#else
+    string catalogName;
+    if (!normalizeSharedCatalogName(name, catalogName)) {
+        cerr << "Error: '" << name << "' is not a valid shared-memory name." << endl;
+        return false;
+    }
+    auto startTime = high_resolution_clock::now();
+
+    vector<const Course*> courses = sortedCoursePointers(hashTable);
+    size_t prerequisiteCount = 0;
+    size_t stringBytes = 0;
+    for (const Course* course : courses) {
+        prerequisiteCount += course->prerequisites.size();
+        stringBytes += course->courseNumber.size() + course->title().size();
+        for (const auto& prereq : course->prerequisites) {
+            stringBytes += prereq.size();
+        }
+    }
+    if (courses.size() >= SHARED_CATALOG_NONE || prerequisiteCount >= SHARED_CATALOG_NONE) {
+        cerr << "Error: The catalog is too large to publish." << endl;
+        return false;
+    }
+
+    auto align = [](uint64_t offset) { return (offset + 7) & ~uint64_t(7); };
+    SharedCatalogHeader layout = {};
+    layout.magic = SHARED_CATALOG_MAGIC;
+    layout.version = SHARED_CATALOG_VERSION;
+    layout.courseCount = static_cast<uint32_t>(courses.size());
+    layout.bucketCount = max<uint32_t>(1, layout.courseCount);
+    layout.bucketsOffset = align(sizeof(SharedCatalogHeader));
+    layout.recordsOffset = align(layout.bucketsOffset + uint64_t(layout.bucketCount) * sizeof(uint32_t));
+    layout.prerequisitesOffset = align(layout.recordsOffset + uint64_t(layout.courseCount) * sizeof(SharedCourseRecord));
+    layout.stringsOffset = layout.prerequisitesOffset + prerequisiteCount * sizeof(SharedCatalogString);
+    layout.totalBytes = max<uint64_t>(layout.stringsOffset + stringBytes, 1);
+
+    size_t controlLength = sizeof(SharedCatalogControl);
+    void* controlAddress = mapSharedObject(catalogName, true, controlLength);
+    if (controlAddress == nullptr) {
+        cerr << "Error: Could not create " << catalogName << ": " << strerror(errno) << endl;
+        return false;
+    }
+    SharedCatalogControl* control = static_cast<SharedCatalogControl*>(controlAddress);
+    if (control->magic == 0) {
+        // A new object is zero-filled, which is generation 0
+        control->magic = SHARED_CATALOG_MAGIC;
+        control->version = SHARED_CATALOG_VERSION;
+    } else if (control->magic != SHARED_CATALOG_MAGIC || control->version != SHARED_CATALOG_VERSION) {
+        cerr << "Error: " << catalogName << " is in use by an incompatible version of this program." << endl;
+        munmap(controlAddress, controlLength);
+        return false;
+    }
+    uint64_t previous = control->generation.load(memory_order_acquire);
+    layout.generation = previous + 1;
+    string segmentName = sharedCatalogSegmentName(catalogName, layout.generation);
+
+    size_t segmentLength = layout.totalBytes;
+    void* address = mapSharedObject(segmentName, true, segmentLength, true);
+    if (address == nullptr && errno == EEXIST) {
+        // Left behind by a publisher that exited before bumping the generation
+        shm_unlink(segmentName.c_str());
+        segmentLength = layout.totalBytes;
+        address = mapSharedObject(segmentName, true, segmentLength, true);
+    }
+    if (address == nullptr) {
+        cerr << "Error: Could not create " << segmentName << ": " << strerror(errno) << endl;
+        munmap(controlAddress, controlLength);
+        return false;
+    }
+
+    char* base = static_cast<char*>(address);
+    memcpy(base, &layout, sizeof(layout));
+    uint32_t* buckets = reinterpret_cast<uint32_t*>(base + layout.bucketsOffset);
+    SharedCourseRecord* records = reinterpret_cast<SharedCourseRecord*>(base + layout.recordsOffset);
+    SharedCatalogString* prerequisites = reinterpret_cast<SharedCatalogString*>(base + layout.prerequisitesOffset);
+    char* strings = base + layout.stringsOffset;
+    uint64_t stringOffset = 0;
+    auto addString = [strings, &stringOffset](string_view value) {
+        SharedCatalogString stored = {stringOffset, static_cast<uint32_t>(value.size()), 0};
+        memcpy(strings + stringOffset, value.data(), value.size());
+        stringOffset += value.size();
+        return stored;
+    };
+
+    fill(buckets, buckets + layout.bucketCount, SHARED_CATALOG_NONE);
+    uint32_t nextPrerequisite = 0;
+    for (uint32_t i = 0; i < layout.courseCount; ++i) {
+        const Course& course = *courses[i];
+        SharedCourseRecord& record = records[i];
+        record.number = addString(course.courseNumber);
+        record.title = addString(course.title());
+        record.firstPrerequisite = nextPrerequisite;
+        record.prerequisiteCount = static_cast<uint32_t>(course.prerequisites.size());
+        record.reserved = 0;
+        for (const auto& prereq : course.prerequisites) {
+            prerequisites[nextPrerequisite++] = addString(prereq);
+        }
+        uint32_t& bucket = buckets[reduceHash(courseKeyHash(course.courseNumber), layout.bucketCount)];
+        record.nextInBucket = bucket;
+        bucket = i;
+    }
+    munmap(address, segmentLength);
+
+    // Readers that load the new generation see a fully written segment
+    control->generation.store(layout.generation, memory_order_release);
+    if (previous != 0) {
+        shm_unlink(sharedCatalogSegmentName(catalogName, previous).c_str());
+    }
+    munmap(controlAddress, controlLength);
+
+    auto duration = duration_cast<microseconds>(high_resolution_clock::now() - startTime);
+    out << "Published " << courses.size() << " courses (" << layout.totalBytes << " bytes) as " << catalogName
+        << ", generation " << layout.generation << ", in " << fixed << setprecision(6)
+        << duration.count() / 1000000.0 << " seconds" << endl;
+    return true;
+#endif
+}
+
+/**
+ * Remove a published catalog; attached readers keep the generation they
+ * have mapped until they exit
+ * @param name The shared-memory name it was published under
+ * @return True if a catalog was removed
+ */
+bool unpublishSharedCatalog(const string& name) {
+#ifdef _WIN32
+    (void)name;
+    cerr << "Error: Shared catalogs require POSIX shared memory." << endl;
+    return false;
+#else
+    string catalogName;
+    if (!normalizeSharedCatalogName(name, catalogName)) {
+        cerr << "Error: '" << name << "' is not a valid shared-memory name." << endl;
+        return false;
+    }
+    size_t length = 0;
+    void* address = mapSharedObject(catalogName, false, length);
+    if (address == nullptr) {
+        cerr << "Error: No catalog has been published as " << catalogName << "." << endl;
+        return false;
+    }
+    const SharedCatalogControl* control = static_cast<const SharedCatalogControl*>(address);
+    if (length >= sizeof(SharedCatalogControl) && control->magic == SHARED_CATALOG_MAGIC) {
+        uint64_t generation = control->generation.load(memory_order_acquire);
+        if (generation != 0) {
+            shm_unlink(sharedCatalogSegmentName(catalogName, generation).c_str());
+        }
+    }
+    munmap(address, length);
+    shm_unlink(catalogName.c_str());
+    cout << "Removed " << catalogName << endl;
+    return true;
+#endif
+}
+
+/**
+ * Read-only advisor session on a published catalog: look up courses and
+ * list the catalog without loading it. Before each request the session
+ * checks the generation and moves to a republished catalog.
+ * @param name The shared-memory name the catalog was published under
+ * @return Process exit status
+ */
+int runSharedCatalogSession(const string& name) {
+#ifdef _WIN32
+    (void)name;
+    cerr << "Error: Shared catalogs require POSIX shared memory." << endl;
+    return 1;
+#else
+    string catalogName;
+    if (!normalizeSharedCatalogName(name, catalogName)) {
+        cerr << "Error: '" << name << "' is not a valid shared-memory name." << endl;
+        return 1;
+    }
+    auto startTime = high_resolution_clock::now();
+    SharedCatalogView catalog;
+    string error;
+    if (!catalog.attach(catalogName, error)) {
+        cerr << "Error: " << error << "." << endl;
+        return 1;
+    }
+    auto duration = duration_cast<microseconds>(high_resolution_clock::now() - startTime);
+    cout << "Attached to " << catalogName << ": " << catalog.size() << " courses, generation "
+         << catalog.generation() << ", in " << duration.count() << " microseconds" << endl;
+
+    string request;
+    while (true) {
+        cout << endl << "Course number (LIST for all courses, blank to quit): ";
+        if (!getline(cin, request)) {
+            break;
+        }
+        string trimmedRequest = trim(request);
+        if (trimmedRequest.empty()) {
+            break;
+        }
+        if (catalog.refresh(error)) {
+            cout << "Catalog republished: now generation " << catalog.generation() << ", "
+                 << catalog.size() << " courses" << endl;
+        } else if (!error.empty()) {
+            cout << "Warning: " << error << "; still showing generation " << catalog.generation() << endl;
+            error.clear();
+        }
+
+        string searchNumber = toUpperCase(trimmedRequest);
+        if (searchNumber == "LIST") {
+            catalog.forEachCourse([&catalog](const SharedCourseRecord& record) {
+                cout << catalog.text(record.number) << ", " << catalog.text(record.title) << '\n';
+            });
+            cout.flush();
+            continue;
+        }
+        const SharedCourseRecord* record = catalog.find(searchNumber);
+        if (record == nullptr) {
+            cout << "Error: Course '" << trimmedRequest << "' not found. Please enter a valid course number." << endl;
+            continue;
+        }
+        cout << renderCourseDetails(catalog.course(*record));
+    }
+    return 0;
+#endif
+}
+
+//=============================================================================
+// Batch Eligibility
+//=============================================================================
+
+// Transcript lines handed to a worker at a time
+const size_t TRANSCRIPT_CHUNK_LINES = 256;
+
+// One chunk of the batch pipeline: the input lines, then the output text
+struct TranscriptChunk {
+    size_t sequence = 0;
+    vector<string> lines;
+    string output;
+};
+
+/**
+ * Evaluate one transcript line: "student,course,course,..."
+ * @param line The input line
+ * @param columns The column store the matrix was built from
+ * @param matrix The prerequisite bit matrix
+ * @param eligible Scratch space for eligible rows
+ * @param scratch Scratch space for the matrix
+ * @param output Receives "student,course,course,...\n"
+ */
+void evaluateTranscriptLine(const string& line, const CourseColumns& columns, const EligibilityMatrix& matrix,
+                            vector<uint32_t>& eligible, vector<uint64_t>& scratch, string& output) {
+    vector<string> fields = split(line, ',');
+    if (fields.empty() || fields[0].empty()) {
+        return;
+    }
+    vector<uint32_t> completedKeyIds;
+    for (size_t i = 1; i < fields.size(); ++i) {
+        if (!fields[i].empty()) {
+            completedKeyIds.push_back(columns.keyId(toUpperCase(fields[i])));
+        }
+    }
+    matrix.eligibleRows(matrix.transcriptBits(completedKeyIds), eligible, scratch);
+    output += fields[0];
+    for (uint32_t row : eligible) {
+        output += ',';
+        output += columns.key(row);
+    }
+    output += '\n';
+}
+
+/**
+ * Compute eligibility for every student in a transcripts file
+ *
+ * The file is streamed through three stages: a reader cutting it into
+ * chunks of lines, a pool of workers parsing and evaluating chunks, and
+ * the calling thread writing results in input order. A fixed number of
+ * chunks circulate through the stages (the reader waits for a free one),
+ * so memory stays flat however long the file is.
+ *
+ * Input lines are "student,completed,completed,..."; output lines are
+ * "student,eligible,eligible,..." with eligible courses in course-number
+ * order. Blank lines are skipped.
+ *
+ * @param hashTable Reference to the hash table containing courses
+ * @param inputFile The transcripts file
+ * @param outputFile The results file to write
+ * @param threadCount Number of worker threads
+ * @param out Stream for the summary
+ * @param err Stream for error messages
+ * @return True if every transcript was evaluated and written
+ */
+bool evaluateTranscriptBatch(HashTable& hashTable, const string& inputFile, const string& outputFile,
+                             unsigned int threadCount, ostream& out = cout, ostream& err = cerr) {
+    ifstream input(inputFile);
+    if (!input.is_open()) {
+        err << "Error: Could not open file " << inputFile << endl;
+        return false;
+    }
+    BufferedFileWriter writer;
+    if (!writer.open(outputFile)) {
+        err << "Error: Could not create file " << outputFile << endl;
+        return false;
+    }
+
+    auto startTime = high_resolution_clock::now();
+    const EligibilityMatrix& matrix = hashTable.eligibility();
+    const CourseColumns& columns = hashTable.columns();
+
+    threadCount = max(1u, threadCount);
+    const size_t chunkCount = 4 * threadCount;
+    BoundedQueue<unique_ptr<TranscriptChunk>> freeChunks(chunkCount);
+    BoundedQueue<unique_ptr<TranscriptChunk>> parsedChunks(chunkCount);
+    BoundedQueue<unique_ptr<TranscriptChunk>> doneChunks(chunkCount);
+    for (size_t i = 0; i < chunkCount; ++i) {
+        freeChunks.push(make_unique<TranscriptChunk>());
+    }
+
+    size_t studentCount = 0;
+    thread reader([&]() {
+        string line;
+        size_t sequence = 0;
+        unique_ptr<TranscriptChunk> chunk;
+        while (input.good() && freeChunks.pop(chunk)) {
+            chunk->sequence = sequence++;
+            chunk->lines.clear();
+            while (chunk->lines.size() < TRANSCRIPT_CHUNK_LINES && getline(input, line)) {
+                chunk->lines.push_back(line);
             }
-            delete current;
-            return true; // Course removed
+            parsedChunks.push(std::move(chunk));
         }
-        prev = current;
-        current = current->next;
+        parsedChunks.close();
+    });
+
+    atomic<unsigned int> runningWorkers{threadCount};
+    vector<thread> workers;
+    for (unsigned int t = 0; t < threadCount; ++t) {
+        workers.emplace_back([&]() {
+            vector<uint32_t> eligible;
+            vector<uint64_t> scratch;
+            unique_ptr<TranscriptChunk> chunk;
+            while (parsedChunks.pop(chunk)) {
+                chunk->output.clear();
+                for (const auto& line : chunk->lines) {
+                    evaluateTranscriptLine(line, columns, matrix, eligible, scratch, chunk->output);
+                }
+                doneChunks.push(std::move(chunk));
+            }
+            if (--runningWorkers == 0) {
+                doneChunks.close();
+            }
+        });
+    }
+
+    // Write chunks in input order, holding early ones until their turn
+    map<size_t, unique_ptr<TranscriptChunk>> waiting;
+    size_t nextSequence = 0;
+    unique_ptr<TranscriptChunk> chunk;
+    while (doneChunks.pop(chunk)) {
+        size_t sequence = chunk->sequence;
+        waiting[sequence] = std::move(chunk);
+        for (auto next = waiting.find(nextSequence); next != waiting.end(); next = waiting.find(++nextSequence)) {
+            writer.append(next->second->output);
+            studentCount += count(next->second->output.begin(), next->second->output.end(), '\n');
+            freeChunks.push(std::move(next->second));
+            waiting.erase(next);
+        }
+    }
+    freeChunks.close();
+    reader.join();
+    for (auto& w : workers) {
+        w.join();
+    }
+
+    if (input.bad() || !writer.close()) {
+        err << "Error: Failed while reading " << inputFile << " or writing " << outputFile << endl;
+        return false;
+    }
+    double seconds = duration_cast<microseconds>(high_resolution_clock::now() - startTime).count() / 1000000.0;
+    out << studentCount << " transcripts evaluated on " << threadCount << " threads, results written to "
+        << outputFile << endl;
+    out << "Time to evaluate: " << fixed << setprecision(6) << seconds << " seconds" << endl;
+    return true;
+}
+
+//=============================================================================
+// Benchmarks
+//=============================================================================
+
+/**
+ * Time lookups of a loaded catalog through the chained table and the
+ * frozen index, for course numbers that exist and for ones that do not
+ * @param filename The catalog to load
+ * @param lookupCount Number of lookups per measurement
+ * @return Process exit status
+ */
+int runLookupBenchmark(const string& filename, size_t lookupCount) {
+    HashTable courseHashTable;
+    ostringstream loadLog;
+    if (!loadCourseData(filename, courseHashTable, loadLog, cerr)) {
+        return 1;
+    }
+    if (courseHashTable.size() == 0) {
+        cerr << "Error: The catalog is empty; there is nothing to look up." << endl;
+        return 1;
+    }
+
+    // Random existing course numbers, and the same numbers with a suffix as misses
+    vector<string> courseNumbers;
+    courseNumbers.reserve(courseHashTable.size());
+    courseHashTable.forEachCourse([&courseNumbers](const Course& course) { courseNumbers.push_back(course.courseNumber); });
+    mt19937 generator(300);
+    vector<string> hits(lookupCount);
+    vector<string> misses(lookupCount);
+    for (size_t i = 0; i < lookupCount; ++i) {
+        hits[i] = courseNumbers[generator() % courseNumbers.size()];
+        misses[i] = hits[i] + "X";
+    }
+
+    auto timeLookups = [&courseHashTable](const vector<string>& keys, size_t& found) {
+        auto start = high_resolution_clock::now();
+        found = 0;
+        for (const auto& key : keys) {
+            found += courseHashTable.find(key) != nullptr;
+        }
+        return duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / static_cast<double>(keys.size());
+    };
+
+    cout << courseHashTable.size() << " courses, " << lookupCount << " lookups per measurement" << endl;
+    size_t found = 0;
+    courseHashTable.setLookupFilterEnabled(false);
+    double unfilteredHit = timeLookups(hits, found);
+    double unfilteredMiss = timeLookups(misses, found);
+    courseHashTable.setLookupFilterEnabled(true);
+    double chainedHit = timeLookups(hits, found);
+    courseHashTable.resetLookupFilterStats();
+    double chainedMiss = timeLookups(misses, found);
+    LookupFilterStats missStats = courseHashTable.lookupFilterStats();
+
+    auto freezeStart = high_resolution_clock::now();
+    if (!courseHashTable.freeze(max(1u, thread::hardware_concurrency()))) {
+        cerr << "Error: Could not build the frozen index." << endl;
+        return 1;
+    }
+    double freezeSeconds = duration_cast<microseconds>(high_resolution_clock::now() - freezeStart).count() / 1000000.0;
+    double frozenHit = timeLookups(hits, found);
+    if (found != lookupCount) {
+        cerr << "Error: Frozen index lost courses (" << found << " of " << lookupCount << " found)." << endl;
+        return 1;
+    }
+    double frozenMiss = timeLookups(misses, found);
+
+    const CourseBloomFilter& filter = courseHashTable.lookupFilter();
+    cout << fixed << setprecision(1);
+    cout << "Chained, no filter: " << unfilteredHit << " ns/hit, " << unfilteredMiss << " ns/miss" << endl;
+    cout << "Chained + filter:   " << chainedHit << " ns/hit, " << chainedMiss << " ns/miss" << endl;
+    cout << "Frozen + filter:    " << frozenHit << " ns/hit, " << frozenMiss << " ns/miss" << endl;
+    cout << "Filter: " << filter.bytes() / 1024 << " KiB, " << missStats.rejected << " of " << lookupCount
+         << " misses rejected, " << missStats.falsePositives << " false positives ("
+         << setprecision(3) << 100.0 * missStats.falsePositives / lookupCount << "%)" << endl;
+    cout << "Freeze time:        " << setprecision(6) << freezeSeconds << " seconds" << endl;
+    return 0;
+}
+
+/**
+ * Time eligibility checks for random transcripts: checking every course's
+ * prerequisites against a set of course numbers, and one pass over the
+ * prerequisite bit matrix
+ * @param filename The catalog to load
+ * @param transcriptCount Number of transcripts per measurement
+ * @return Process exit status
+ */
+int runEligibilityBenchmark(const string& filename, size_t transcriptCount) {
+    HashTable courseHashTable;
+    ostringstream loadLog;
+    if (!loadCourseData(filename, courseHashTable, loadLog, cerr)) {
+        return 1;
+    }
+    if (courseHashTable.size() == 0) {
+        cerr << "Error: The catalog is empty; there are no courses to check." << endl;
+        return 1;
+    }
+
+    // Transcripts of 5 to 60 random courses
+    vector<string> courseNumbers;
+    courseNumbers.reserve(courseHashTable.size());
+    courseHashTable.forEachCourse([&courseNumbers](const Course& course) { courseNumbers.push_back(course.courseNumber); });
+    mt19937 generator(300);
+    vector<vector<string>> transcripts(transcriptCount);
+    for (auto& transcript : transcripts) {
+        size_t length = 5 + generator() % 56;
+        for (size_t i = 0; i < length; ++i) {
+            transcript.push_back(courseNumbers[generator() % courseNumbers.size()]);
+        }
+    }
+
+    // Per course: look up each prerequisite in the transcript
+    auto start = high_resolution_clock::now();
+    size_t scanEligible = 0;
+    for (const auto& transcript : transcripts) {
+        unordered_set<string> completed(transcript.begin(), transcript.end());
+        courseHashTable.forEachCourse([&](const Course& course) {
+            if (completed.count(course.courseNumber) != 0) {
+                return;
+            }
+            for (const auto& prereq : course.prerequisites) {
+                if (completed.count(prereq) == 0) {
+                    return;
+                }
+            }
+            ++scanEligible;
+        });
+    }
+    double scanMicros = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / 1000.0 / transcriptCount;
+
+    // Bit matrix, the way printEligibleCourses queries it: the table's
+    // cached matrix, built by the first query and reused by the rest
+    vector<uint32_t> eligible;
+    vector<uint64_t> scratch;
+    vector<uint32_t> keyIds;
+    size_t matrixEligible = 0;
+    auto query = [&](const vector<string>& transcript) {
+        const EligibilityMatrix& matrix = courseHashTable.eligibility();
+        const CourseColumns& columns = courseHashTable.columns();
+        keyIds.clear();
+        for (const auto& courseNumber : transcript) {
+            keyIds.push_back(columns.keyId(courseNumber));
+        }
+        matrix.eligibleRows(matrix.transcriptBits(keyIds), eligible, scratch);
+        matrixEligible += eligible.size();
+    };
+    start = high_resolution_clock::now();
+    query(transcripts[0]);
+    double firstQuerySeconds = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1000000.0;
+    start = high_resolution_clock::now();
+    for (size_t t = 1; t < transcriptCount; ++t) {
+        query(transcripts[t]);
+    }
+    double matrixMicros = transcriptCount < 2 ? 0.0
+        : duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / 1000.0 / (transcriptCount - 1);
+
+    if (matrixEligible != scanEligible) {
+        cerr << "Error: Bit matrix found " << matrixEligible << " eligible courses, the scan " << scanEligible << "." << endl;
+        return 1;
+    }
+
+    cout << courseHashTable.size() << " courses, " << transcriptCount << " transcripts, "
+         << scanEligible / transcriptCount << " eligible courses per transcript on average" << endl;
+    cout << fixed << setprecision(1);
+    cout << "Per-course scan: " << scanMicros << " us/transcript" << endl;
+    if (transcriptCount > 1) {
+        cout << "Bit matrix:      " << matrixMicros << " us/transcript (" << scanMicros / matrixMicros << "x), cached matrix" << endl;
+    }
+    cout << "First query:     " << firstQuerySeconds * 1000000.0 << " us, including the matrix build" << endl;
+    cout << "Matrix: " << courseHashTable.eligibility().bytes() / 1024 << " KiB" << endl;
+    return 0;
+}
+
+/**
+ * Time sorting a loaded catalog's course pointers by course number with
+ * the comparison std::sort the listing used to run, the radix sort on
+ * one thread, and the radix sort across all cores
+ * @param filename The catalog to load
+ * @param rounds Number of sorts per measurement (the best one counts)
+ * @return Process exit status
+ */
+int runSortBenchmark(const string& filename, size_t rounds) {
+    HashTable courseHashTable;
+    ostringstream loadLog;
+    if (!loadCourseData(filename, courseHashTable, loadLog, cerr)) {
+        return 1;
+    }
+    vector<const Course*> tableOrder;
+    tableOrder.reserve(courseHashTable.size());
+    courseHashTable.forEachCourse([&tableOrder](const Course& course) { tableOrder.push_back(&course); });
+    auto courseNumberOf = [](const Course* course) { return string_view(course->courseNumber); };
+    unsigned int threadCount = max(1u, thread::hardware_concurrency());
+
+    // Best of several rounds, each starting from table order
+    vector<const Course*> expected;
+    auto timeSort = [&](auto sortPath) {
+        double best = numeric_limits<double>::max();
+        for (size_t round = 0; round < rounds; ++round) {
+            vector<const Course*> courses = tableOrder;
+            auto start = high_resolution_clock::now();
+            sortPath(courses);
+            best = min(best, duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / 1e9);
+            if (expected.empty()) {
+                expected = courses;
+            } else if (courses != expected) {
+                best = -1;
+            }
+        }
+        return best;
+    };
+
+    double comparisonSeconds = timeSort([](vector<const Course*>& courses) {
+        sort(courses.begin(), courses.end(), [](const Course* a, const Course* b) {
+            return a->courseNumber < b->courseNumber;
+        });
+    });
+    double radixSeconds = timeSort([&](vector<const Course*>& courses) {
+        sortByCourseNumber(courses, courseNumberOf);
+    });
+    double parallelSeconds = timeSort([&](vector<const Course*>& courses) {
+        sortByCourseNumber(courses, courseNumberOf, threadCount);
+    });
+    if (radixSeconds < 0 || parallelSeconds < 0) {
+        cerr << "Error: Radix sort order differs from std::sort." << endl;
+        return 1;
+    }
+
+    cout << tableOrder.size() << " courses, best of " << rounds << " sorts" << endl;
+    cout << fixed << setprecision(6);
+    cout << "std::sort:            " << comparisonSeconds << " seconds" << endl;
+    cout << "Radix sort:           " << radixSeconds << " seconds (" << setprecision(2)
+         << comparisonSeconds / max(radixSeconds, 1e-9) << "x)" << setprecision(6) << endl;
+    cout << "Radix sort, " << threadCount << " threads: " << parallelSeconds << " seconds (" << setprecision(2)
+         << comparisonSeconds / max(parallelSeconds, 1e-9) << "x)" << endl;
+    return 0;
+}
+
+/**
+ * Time inserting a parsed catalog by copying each course (the old path)
+ * and by moving it into its node, and the whole load path end to end.
+ * With -DCOURSE_COUNT_ALLOCATIONS also reports heap allocations per course.
+ * @param filename The catalog to load
+ * @return Process exit status
+ */
+int runInsertBenchmark(const string& filename) {
+    vector<ParsedCatalogFile> files(1);
+    files[0].filename = filename;
+    parseCourseFile(files[0]);
+    if (!files[0].opened || files[0].errorLine != 0 || !files[0].readError.empty() || !validateCatalog(files, cout, cerr)) {
+        cerr << "Error: " << filename << " is not a valid catalog." << endl;
+        return 1;
+    }
+    const vector<Course>& courses = files[0].courses;
+    const double courseCount = static_cast<double>(max<size_t>(1, courses.size()));
+
+    // Run one insert path on a fresh table, returning seconds and allocations per course
+    auto measure = [](auto insertPath, double& allocationsPerCourse, double perCourse) {
+        HashTable courseHashTable;
+        size_t allocationsBefore = heapAllocations();
+        auto start = high_resolution_clock::now();
+        insertPath(courseHashTable);
+        double seconds = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1000000.0;
+        allocationsPerCourse = (heapAllocations() - allocationsBefore) / perCourse;
+        return seconds;
+    };
+
+    double copyAllocations = 0;
+    double copySeconds = measure([&courses](HashTable& table) {
+        table.reserve(courses.size());
+        for (const auto& course : courses) {
+            table.insert(course);
+        }
+    }, copyAllocations, courseCount);
+
+    vector<Course> movable = courses;
+    double moveAllocations = 0;
+    double moveSeconds = measure([&movable](HashTable& table) {
+        table.insertAll(std::move(movable));
+    }, moveAllocations, courseCount);
+
+    // Concurrent insert at 1, 2, 4, ... threads up to the core count
+    vector<pair<unsigned int, double>> concurrentSeconds;
+    unsigned int maxThreads = max(1u, thread::hardware_concurrency());
+    for (unsigned int threads = 1; ; threads = min(threads * 2, maxThreads)) {
+        vector<Course> batch = courses;
+        double unusedAllocations = 0;
+        concurrentSeconds.emplace_back(threads, measure([&batch, threads](HashTable& table) {
+            table.insertAllConcurrent(std::move(batch), threads);
+        }, unusedAllocations, courseCount));
+        if (threads == maxThreads) {
+            break;
+        }
+    }
+
+    double loadAllocations = 0;
+    double loadSeconds = measure([&filename](HashTable& table) {
+        ostringstream loadLog;
+        loadCourseData(filename, table, loadLog, loadLog);
+    }, loadAllocations, courseCount);
+
+    cout << courses.size() << " courses" << endl;
+    cout << fixed << setprecision(6);
+    cout << "Copy insert:  " << copySeconds << " seconds";
+#ifdef COURSE_COUNT_ALLOCATIONS
+    cout << ", " << setprecision(2) << copyAllocations << " allocations/course" << setprecision(6);
+#endif
+    cout << endl << "Move insert:  " << moveSeconds << " seconds";
+#ifdef COURSE_COUNT_ALLOCATIONS
+    cout << ", " << setprecision(2) << moveAllocations << " allocations/course" << setprecision(6);
+#endif
+    cout << endl;
+    for (const auto& run : concurrentSeconds) {
+        cout << "Concurrent insert, " << run.first << (run.first == 1 ? " thread:  " : " threads: ") << run.second
+             << " seconds (" << setprecision(2) << concurrentSeconds[0].second / max(run.second, 1e-9)
+             << "x)" << setprecision(6) << endl;
+    }
+    cout << "Full load:    " << loadSeconds << " seconds";
+#ifdef COURSE_COUNT_ALLOCATIONS
+    cout << ", " << setprecision(2) << loadAllocations << " allocations/course";
+#else
+    cout << endl << "(build with -DCOURSE_COUNT_ALLOCATIONS to count allocations)";
+#endif
+    cout << endl;
+    return 0;
+}
+
+//=============================================================================
+// Query Server (Unix domain socket, Linux only)
+//=============================================================================
+
+// Default socket path shared with CourseClient.cpp
+const string DEFAULT_SOCKET_PATH = "/tmp/abcu_courses.sock";
+
+/**
+ * Split a request line into its (uppercased) command word and argument text
+ * @param request The request line without its trailing newline
+ * @param command Set to the command word
+ * @param argument Set to the trimmed remainder of the line
+ */
+void splitServerRequest(const string& request, string& command, string& argument) {
+    string line = trim(request);
+    size_t space = line.find(' ');
+    command = toUpperCase(line.substr(0, space));
+    argument = space == string::npos ? "" : trim(line.substr(space + 1));
+}
+
+/**
+ * Execute a short protocol request against the catalog
+ *
+ * Requests are one line each:
+ *   LIST | COURSE <number> | ADD <number>|<title>|<prereqs> |
+ *   REMOVE <number> [FORCE] [CLEANUP] | LOAD <file> | EXPORT <file> [SORTED] |
+ *   DEPT [<department> [<low>-<high>]] | CHAINS [<number>] | STATS | PING | HELP | QUIT
+ * LIST, LOAD and EXPORT are long-running and handled by the server's coroutines.
+ *
+ * @param request The request line without its trailing newline
+ * @param hashTable Reference to the hash table containing courses
+ * @param out Stream for the response body
+ * @param closeConnection Set to true when the client asked to disconnect
+ * @return True for an OK response, false for an ERR response
+ */
+bool handleServerRequest(const string& request, HashTable& hashTable, ostream& out, bool& closeConnection,
+                         CourseJournal* journal = nullptr) {
+    string command;
+    string argument;
+    splitServerRequest(request, command, argument);
+
+    if (command == "COURSE") {
+        return printCourseInformation(hashTable, argument, out);
+    }
+
+    if (command == "ADD") {
+        // Title may contain commas, so fields are separated by '|'
+        size_t firstBar = argument.find('|');
+        if (firstBar == string::npos) {
+            out << "Error: Expected ADD <number>|<title>|<prerequisites>" << endl;
+            return false;
+        }
+        size_t secondBar = argument.find('|', firstBar + 1);
+        Course newCourse;
+        newCourse.courseNumber = toUpperCase(trim(argument.substr(0, firstBar)));
+        newCourse.courseTitle = trim(argument.substr(firstBar + 1, secondBar == string::npos ? string::npos : secondBar - firstBar - 1));
+        string prereqInput = secondBar == string::npos ? "" : argument.substr(secondBar + 1);
+        if (journal != nullptr) {
+            journal->beginOperation();
+        }
+        return addCourseRecord(hashTable, newCourse, prereqInput, out, journal);
+    }
+
+    if (command == "REMOVE") {
+        vector<string> words;
+        stringstream ss(argument);
+        string word;
+        while (ss >> word) {
+            words.push_back(toUpperCase(word));
+        }
+        if (words.empty()) {
+            out << "Error: Course number cannot be empty." << endl;
+            return false;
+        }
+        const string& courseNumber = words[0];
+        bool force = find(words.begin() + 1, words.end(), "FORCE") != words.end();
+        bool cleanup = find(words.begin() + 1, words.end(), "CLEANUP") != words.end();
+
+        if (hashTable.find(courseNumber) == nullptr) {
+            out << "Error: Course " << courseNumber << " not found." << endl;
+            return false;
+        }
+
+        // Mirror the menu's confirmation step: dependents require FORCE
+        vector<string> dependentCourses = findDependentCourses(hashTable, courseNumber);
+        if (!dependentCourses.empty() && !force) {
+            out << "WARNING: " << courseNumber << " is a prerequisite for:" << endl;
+            for (const auto& dep : dependentCourses) {
+                out << "  - " << dep << endl;
+            }
+            out << "Resend with FORCE to remove anyway." << endl;
+            return false;
+        }
+
+        if (journal != nullptr) {
+            journal->beginOperation();
+        }
+        removeCourseRecord(hashTable, courseNumber, journal);
+        out << "Course " << courseNumber << " removed successfully." << endl;
+        if (cleanup) {
+            removePrerequisiteFromAllCourses(hashTable, courseNumber, journal);
+            out << "Prerequisite cleanup completed." << endl;
+        }
+        return true;
+    }
+
+    if (command == "EDIT") {
+        // Same field layout as ADD; an empty field keeps the current value
+        size_t firstBar = argument.find('|');
+        if (firstBar == string::npos) {
+            out << "Error: Expected EDIT <number>|<title>|<prerequisites>" << endl;
+            return false;
+        }
+        size_t secondBar = argument.find('|', firstBar + 1);
+        string newTitle = argument.substr(firstBar + 1, secondBar == string::npos ? string::npos : secondBar - firstBar - 1);
+        string prereqInput = secondBar == string::npos ? "" : argument.substr(secondBar + 1);
+        if (journal != nullptr) {
+            journal->beginOperation();
+        }
+        return editCourseRecord(hashTable, argument.substr(0, firstBar), newTitle, prereqInput, out, journal);
+    }
+
+    if (command == "BULKADD") {
+        if (journal != nullptr) {
+            journal->beginOperation();
+        }
+        return bulkAddCourses(argument, hashTable, out, out, journal);
+    }
+
+    if (command == "UNDO") {
+        if (journal == nullptr || !journal->isOpen()) {
+            out << "Error: Undo requires an open journal." << endl;
+            return false;
+        }
+        return journal->undoLast(hashTable, out);
+    }
+
+    if (command == "FREEZE") {
+        return freezeCatalog(hashTable, out);
+    }
+
+    if (command == "ELIGIBLE") {
+        return printEligibleCourses(hashTable, argument, out);
+    }
+
+    if (command == "DEPT") {
+        return printDepartmentCourses(hashTable, argument, out);
+    }
+
+    if (command == "CHAINS") {
+        return printPrerequisiteChains(hashTable, argument, out);
+    }
+
+    if (command == "STATS") {
+        return printCatalogStats(hashTable, out);
+    }
+
+    if (command == "PING") {
+        out << "PONG" << endl;
+        return true;
+    }
+
+    if (command == "QUIT") {
+        closeConnection = true;
+        out << "Goodbye!" << endl;
+        return true;
+    }
+
+    if (command == "HELP") {
+        out << "LIST" << endl;
+        out << "COURSE <number>" << endl;
+        out << "ADD <number>|<title>|<prerequisites>" << endl;
+        out << "REMOVE <number> [FORCE] [CLEANUP]" << endl;
+        out << "EDIT <number>|<title>|<prerequisites>" << endl;
+        out << "BULKADD <file>" << endl;
+        out << "UNDO" << endl;
+        out << "FREEZE" << endl;
+        out << "ELIGIBLE <completed courses>" << endl;
+        out << "DEPT [<department> [<low>-<high>]]" << endl;
+        out << "CHAINS [<number>]" << endl;
+        out << "STATS" << endl;
+        out << "LOAD <file>" << endl;
+        out << "EXPORT <file.csv|file.jsonl> [SORTED]" << endl;
+        out << "PING" << endl;
+        out << "QUIT" << endl;
+        return true;
     }
 
-    return false; // Course not found
+    out << "Error: Unknown command '" << command << "'. Send HELP for a list of commands." << endl;
+    return false;
+}
 
+#ifdef COURSE_SERVER_AVAILABLE
 
-}
-};
+// Units of work (listing lines, parsed rows, merge steps) between yields
+#ifndef SERVER_CHUNK_LINES
+#define SERVER_CHUNK_LINES 512
+#endif
 
-//=============================================================================
-// Utility Functions
-//=============================================================================
+// Pipelined requests answered back-to-back before a connection yields its turn
+const int SERVER_REQUESTS_PER_TURN = 64;
 
 /**
- * Converts a string to uppercase
- * @param str The string to convert
- * @return The uppercase version of the string
+ * Coroutine for one server request
+ * Handlers start suspended, are resumed by the server's executor, may
+ * co_await YieldToExecutor{} between chunks of work, and co_return
+ * true/false for an OK/ERR response
  */
-string toUpperCase(string str) {
-    transform(str.begin(), str.end(), str.begin(), ::toupper);
-    return str;
-}   
-// Remove a prerequisite from all courses in the hash table
-void removePrerequisiteFromAllCourses(HashTable& hashTable, const string& removedCourseNumber) {
-    vector<Course> allCourses = hashTable.getAllCourses();
-    for (auto& course : allCourses) {
-        auto& prereqs = course.prerequisites;
-        size_t oldSize = prereqs.size();
-        prereqs.erase(remove(prereqs.begin(), prereqs.end(), removedCourseNumber), prereqs.end());
-        if (prereqs.size() != oldSize) {
-            // Only update if a prerequisite was actually removed
-            hashTable.remove(course.courseNumber);
-            hashTable.insert(course);
+class RequestTask {
+public:
+    struct promise_type {
+        bool ok = false;
+
+        RequestTask get_return_object() {
+            return RequestTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_value(bool result) { ok = result; }
+        void unhandled_exception() { ok = false; }
+    };
+
+    RequestTask() = default;
+    explicit RequestTask(std::coroutine_handle<promise_type> aHandle) : handle(aHandle) {}
+    RequestTask(RequestTask&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    RequestTask& operator=(RequestTask&& other) noexcept {
+        if (this != &other) {
+            reset();
+            handle = std::exchange(other.handle, nullptr);
         }
+        return *this;
     }
-}
+    RequestTask(const RequestTask&) = delete;
+    RequestTask& operator=(const RequestTask&) = delete;
+    ~RequestTask() { reset(); }
+
+    bool valid() const { return static_cast<bool>(handle); }
+    bool done() const { return handle.done(); }
+    bool succeeded() const { return handle.promise().ok; }
+    void resume() { handle.resume(); }
+
+    // Destroy the coroutine frame, running destructors of any suspended locals
+    void reset() {
+        if (handle) {
+            handle.destroy();
+            handle = nullptr;
+        }
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle;
+};
+
+// Suspend the current request and let the executor run other connections
+struct YieldToExecutor : std::suspend_always {};
+
 /**
- * Trims leading and trailing whitespace from a string
- * @param str The string to trim
- * @return The trimmed string
+ * Coordinates requests that hold course pointers across yields with
+ * requests that modify the catalog. Everything runs on the executor
+ * thread, so this is bookkeeping rather than a lock: a writer simply
+ * waits until no reader is suspended mid-iteration.
  */
-string trim(const string& str) {
-    size_t first = str.find_first_not_of(" \t\r\n");
-        if (first == string::npos)
-            return "";
-    size_t last = str.find_last_not_of(" \t\r\n");
-    return str.substr(first, (last - first + 1));
+struct CatalogAccess {
+    int activeReaders = 0;  // Readers suspended while holding course pointers
+    int waitingWriters = 0; // Writers waiting for those readers to finish
+};
+
+// Registers a reader for the lifetime of a handler, even if the handler is destroyed early
+class CatalogReadGuard {
+public:
+    explicit CatalogReadGuard(CatalogAccess& anAccess) : access(anAccess) { ++access.activeReaders; }
+    ~CatalogReadGuard() { --access.activeReaders; }
+private:
+    CatalogAccess& access;
+};
+
+// Registers a waiting writer so that new readers queue behind it
+class CatalogWriteIntent {
+public:
+    explicit CatalogWriteIntent(CatalogAccess& anAccess) : access(anAccess) { ++access.waitingWriters; }
+    ~CatalogWriteIntent() { --access.waitingWriters; }
+private:
+    CatalogAccess& access;
+};
+
+// Wrap the result of a request that already completed synchronously
+RequestTask completedRequest(bool ok) {
+    co_return ok;
 }
 
 /**
- * Split a string by a delimiter
- * @param str The string to split
- * @param delimiter The delimiter character
- * @return A vector of tokens
+ * Run a catalog mutation once no reader is suspended inside the catalog
+ * @param access Reader/writer bookkeeping for the catalog
+ * @param operation The mutation; it runs without yielding
  */
-
- vector<string> split(const string& str, char delimiter) {
-    vector<string> tokens;
-    stringstream ss(str);
-    string token;
-
-    while (getline(ss, token, delimiter)) {
-        tokens.push_back(trim(token));
+RequestTask runExclusive(CatalogAccess& access, function<bool()> operation) {
+    CatalogWriteIntent intent(access);
+    while (access.activeReaders > 0) {
+        co_await YieldToExecutor{};
     }
+    co_return operation();
+}
 
-    return tokens;
- }
+/**
+ * Collects and sorts course pointers a bounded amount of work at a time,
+ * so that a coroutine can yield between steps. Uses a bottom-up merge
+ * sort (sorted runs, then merge passes that can pause anywhere) and
+ * produces the same order as printCourseList.
+ */
+class IncrementalCourseSorter {
+public:
+    IncrementalCourseSorter(const HashTable& aTable, size_t aChunk) : hashTable(aTable), chunk(aChunk) {}
 
- //=============================================================================
- // Core Functionality Functions
- //=============================================================================
+    /**
+     * Do up to one chunk of work
+     * @return True once sorted() holds the finished result
+     */
+    bool step() {
+        switch (phase) {
+        case Phase::Collect:
+            hashTable.forEachCourse([this](const Course& course) { courses.push_back(&course); },
+                                    bucket, bucket + static_cast<unsigned int>(chunk));
+            bucket += static_cast<unsigned int>(chunk);
+            if (bucket >= hashTable.bucketCount()) {
+                phase = Phase::SortRuns;
+            }
+            return false;
 
- /**
-  * Load course data from CSV file into hash table
-  * @param filename Path to the CSV file
-  * @param hashTable Reference to the hash table
-  * @return True if loading is successful, false otherwise
-  */
- bool loadCourseData(const string& filename, HashTable& hashTable) {
-    // Start timing
-    auto startTime = high_resolution_clock::now();
-    clock_t startTicks = clock();
+        case Phase::SortRuns:
+            sort(courses.begin() + runStart, courses.begin() + min(runStart + chunk, courses.size()), lessByNumber);
+            runStart += chunk;
+            if (runStart >= courses.size()) {
+                phase = Phase::Merge;
+                merged.resize(courses.size());
+                width = chunk;
+                startMerge(0);
+            }
+            return false;
 
-    ifstream file(filename);
+        case Phase::Merge:
+            for (size_t budget = 4 * chunk; budget > 0 && width < courses.size(); --budget) {
+                if (k == right) {
+                    // This pair is merged; move to the next pair or the next pass
+                    if (right < courses.size()) {
+                        startMerge(right);
+                    } else {
+                        courses.swap(merged);
+                        width *= 2;
+                        startMerge(0);
+                    }
+                    continue;
+                }
+                merged[k++] = (j >= right || (i < middle && !lessByNumber(courses[j], courses[i]))) ? courses[i++] : courses[j++];
+            }
+            if (width >= courses.size()) {
+                phase = Phase::Done;
+                return true;
+            }
+            return false;
 
-    // Check if file opened successfully
-    if (!file.is_open()) {
-        cerr << "Error: Could not open file " << filename << "'" << endl;
-        return false;
-    } else { 
-        cout << filename << " loaded successfully!" << endl;
+        case Phase::Done:
+            return true;
+        }
+        return true;
     }
- 
-
- // Temporary vector to store courses for validation
- vector<Course> tempCourses;
- string line;
- int lineNumber = 0;
- 
- // Read file line by line
- while (getline(file, line)) {
-    lineNumber++;
 
-    // Skip empty lines
-    if (trim(line).empty()) {
-        continue;
+    const vector<const Course*>& sorted() const {
+        return courses;
     }
 
-    // Parse the line
-    vector<string> tokens = split(line, ',');
+private:
+    enum class Phase { Collect, SortRuns, Merge, Done };
 
-    // Validate the number of tokens (at least course number and title)
-    if (tokens.size() < 2) {
-        cerr << "Error: Line " << lineNumber << " - Invalid format (missing course number or title)" << endl;
-        cerr << "Line: " << line << endl;
-        file.close();
-        return false;
+    static bool lessByNumber(const Course* a, const Course* b) {
+        return a->courseNumber < b->courseNumber;
     }
 
-    // Create a Course object
-    Course course;
-    course.courseNumber = toUpperCase(tokens[0]);
-    course.courseTitle = tokens[1];
-
-    // Extract prerequisites if they exist (tokens from index 2 onward)
-    for (size_t i = 2; i < tokens.size(); ++i) {
-        if (!tokens[i].empty()) {
-            course.prerequisites.push_back(toUpperCase(tokens[i]));
-        }
+    // Set up the merge of the two runs starting at left
+    void startMerge(size_t left) {
+        middle = min(left + width, courses.size());
+        right = min(left + 2 * width, courses.size());
+        i = left;
+        j = middle;
+        k = left;
     }
 
-    tempCourses.push_back(course);
- }
+    const HashTable& hashTable;
+    size_t chunk;
+    Phase phase = Phase::Collect;
+    vector<const Course*> courses;
+    vector<const Course*> merged;
+    unsigned int bucket = 0;
+    size_t runStart = 0;
+    size_t width = 0;
+    size_t middle = 0, right = 0, i = 0, j = 0, k = 0;
+};
 
-file.close();
+/**
+ * Coroutine version of printCourseList for the server
+ * Collection, sorting and printing are split into chunks so that short
+ * lookups on other connections are answered between them
+ * @param hashTable Reference to the hash table containing courses
+ * @param out Stream for the listing; the executor streams it out at each yield
+ * @param access Reader/writer bookkeeping for the catalog
+ */
+RequestTask streamCourseList(HashTable& hashTable, ostream& out, CatalogAccess& access) {
+    // Writers that are already waiting go first so they cannot be starved
+    while (access.waitingWriters > 0) {
+        co_await YieldToExecutor{};
+    }
+    CatalogReadGuard guard(access);
 
-// Validate that all prerequisites exist as courses
-for (const auto& course : tempCourses) {
-    for (const auto& prereq : course.prerequisites) {
-        bool found = false;
+    // Start timing
+    auto startTime = high_resolution_clock::now();
+    clock_t startTicks = clock();
 
-        // Search for prerequisite in the temporary course list
-        for (const auto& existingCourse : tempCourses) {
-            if (existingCourse.courseNumber == prereq) {
-                found = true;
-                break;
-            }
-        }
+    // Collect and sort pointers (not copies) a chunk at a time
+    IncrementalCourseSorter sorter(hashTable, SERVER_CHUNK_LINES);
+    while (!sorter.step()) {
+        co_await YieldToExecutor{};
+    }
+    const vector<const Course*>& courses = sorter.sorted();
+    const size_t count = courses.size();
 
-        if (!found) {
-            cerr << "Error: Prerequisite '" << prereq << "' for course '"
-                 << course.courseNumber << "' does not exist in the course list." << endl;
-            return false;
-        }
+    // Check if courses are loaded
+    if (courses.empty()) {
+        out << "No courses loaded. Please load data first (Option 1)." << endl;
+        co_return false;
     }
-}
+    out << "Courses loaded successfully!" << endl;
 
-// All validations passed, insert courses into the hash table
-for (const auto& course : tempCourses) {
-    hashTable.insert(course);
-}
+    // Print header
+    out << "Here is a sample schedule:" << endl;
+    out << endl;
 
-// End timing
-auto endTime = high_resolution_clock::now();
-clock_t endTicks = clock();
+    // Print each course, handing the executor a chunk at a time
+    for (size_t i = 0; i < count; ++i) {
+        out << courses[i]->courseNumber << ", " << courses[i]->title() << '\n';
+        if ((i + 1) % SERVER_CHUNK_LINES == 0) {
+            co_await YieldToExecutor{};
+        }
+    }
 
-// Calculate elapsed time
-auto duration = duration_cast<microseconds>(endTime - startTime);
-double seconds = duration.count() / 1000000.0;
-clock_t ticks = endTicks - startTicks;
+    // End timing
+    auto endTime = high_resolution_clock::now();
+    clock_t endTicks = clock();
 
-// Display performance metrics
-cout << tempCourses.size() << " courses loaded." << endl;
-cout << "Time to load: " << ticks << " clock ticks" << endl;
-cout << "Time to load: " << fixed << setprecision(6) << seconds << " seconds" << endl;
+    // Calculate elapsed time
+    auto duration = duration_cast<microseconds>(endTime - startTime);
+    double seconds = duration.count() / 1000000.0;
+    clock_t ticks = endTicks - startTicks;
 
-return true;
+    out << "Time to print: " << ticks << " clock ticks" << endl;
+    out << "Time to print: " << fixed << setprecision(6) << seconds << " seconds" << endl;
+    out << endl;
+    co_return true;
 }
 
 /**
- * Print all courses in alphanumeric order
+ * Coroutine version of exportCourseData for the server's EXPORT request
+ * The export is written to a file on the server in the background, a
+ * chunk of courses between yields, while other requests are answered
+ * @param argument "<file> [SORTED]"; the format follows the file extension
  * @param hashTable Reference to the hash table containing courses
+ * @param out Stream for status, timing and error messages
+ * @param access Reader/writer bookkeeping for the catalog
  */
+RequestTask streamCatalogExport(string argument, HashTable& hashTable, ostream& out, CatalogAccess& access, CourseJournal& journal) {
+    bool sorted = false;
+    size_t lastSpace = argument.find_last_of(' ');
+    if (lastSpace != string::npos && toUpperCase(argument.substr(lastSpace + 1)) == "SORTED") {
+        sorted = true;
+        argument = trim(argument.substr(0, lastSpace));
+    }
+    const string& filename = argument;
+    ExportFormat format = exportFormatForFile(filename);
+
+    while (access.waitingWriters > 0) {
+        co_await YieldToExecutor{};
+    }
+    CatalogReadGuard guard(access);
 
-void printCourseList(HashTable& hashTable) {
     // Start timing
     auto startTime = high_resolution_clock::now();
     clock_t startTicks = clock();
 
-    // Get all courses from hash table
-    vector<Course> courses = hashTable.getAllCourses();
-    
-    // Check if courses are loaded
-    if (courses.empty()) {
-        cerr << "No courses loaded. Please load data first (Option 1)." << endl;
-        return;
-    } else {
-        cout << "Courses loaded successfully!" << endl;
+    if (hashTable.size() == 0) {
+        out << "No courses loaded. Please load data first (Option 1)." << endl;
+        co_return false;
+    }
+    if (!checkExportFileName(filename, out)) {
+        co_return false;
     }
 
-    // Sort courses alphanumerically by course number
-    sort(courses.begin(), courses.end(), 
-        [](const Course& a, const Course& b) {
-            return a.courseNumber < b.courseNumber;
-        });
-        
-    // Print header
-    cout << "Here is a sample schedule:" << endl;
-    cout << endl;
+    BufferedFileWriter writer;
+    if (filename.empty() || !writer.open(filename)) {
+        out << "Error: Could not open file '" << filename << "' for writing" << endl;
+        co_return false;
+    }
 
-    // Print each course
-    for (const auto& course : courses) {
-        cout << course.courseNumber << ", " << course.courseTitle << endl;
+    size_t written = 0;
+    if (sorted) {
+        IncrementalCourseSorter sorter(hashTable, SERVER_CHUNK_LINES);
+        while (!sorter.step()) {
+            co_await YieldToExecutor{};
+        }
+        for (const Course* course : sorter.sorted()) {
+            writeCourseRecord(writer, *course, format);
+            if (++written % SERVER_CHUNK_LINES == 0) {
+                co_await YieldToExecutor{};
+            }
+        }
+    } else {
+        for (unsigned int bucket = 0; bucket < hashTable.bucketCount(); bucket += SERVER_CHUNK_LINES) {
+            hashTable.forEachCourse([&](const Course& course) {
+                writeCourseRecord(writer, course, format);
+                ++written;
+            }, bucket, bucket + SERVER_CHUNK_LINES);
+            co_await YieldToExecutor{};
+        }
+    }
+
+    size_t bytes = writer.bytesWritten();
+    if (!writer.close()) {
+        out << "Error: Failed while writing '" << filename << "'" << endl;
+        co_return false;
     }
 
     // End timing
@@ -423,55 +7609,86 @@ void printCourseList(HashTable& hashTable) {
     double seconds = duration.count() / 1000000.0;
     clock_t ticks = endTicks - startTicks;
 
-    cout << "Time to print: " << ticks << " clock ticks" << endl;
-    cout << "Time to print: " << fixed << setprecision(6) << seconds << " seconds" << endl;
-    cout << endl;
+    out << written << " courses exported to " << filename << " (" << bytes << " bytes, "
+        << (format == ExportFormat::Csv ? "CSV" : "JSON Lines") << ")." << endl;
+    out << "Time to export: " << ticks << " clock ticks" << endl;
+    out << "Time to export: " << fixed << setprecision(6) << seconds << " seconds" << endl;
+    journal.snapshotSaved(filename, out);
+    co_return true;
 }
 
 /**
- * Search for and print a specific course's information
- * @param hashTable Reference to the hash table containing courses
- * @param courseNumber The course number to search for
+ * Coroutine version of loadCourseData for the server's LOAD request
+ * Parses and builds the replacement catalog on the side, yielding between
+ * chunks, then swaps it in once no listing is suspended over the old one
+ * @param filename Path to the CSV file
+ * @param hashTable Reference to the live hash table
+ * @param out Stream for progress, timing and error output
+ * @param access Reader/writer bookkeeping for the catalog
  */
-void printCourseInformation(HashTable& hashTable, const string& courseNumber) {
+RequestTask reloadCatalog(string filename, HashTable& hashTable, ostream& out, CatalogAccess& access, CourseJournal& journal) {
     // Start timing
     auto startTime = high_resolution_clock::now();
     clock_t startTicks = clock();
 
-    // Validate input is not empty or whitespace
-    string trimmedCourse = trim(courseNumber);
-    if (trimmedCourse.empty()) {
-        cout << "Error: Course number cannot be empty. Please enter a valid course number." << endl;
-        return;
+    CatalogLineReader file;
+    if (!file.open(filename)) {
+        out << "Error: Could not open file " << filename << "'" << endl;
+        co_return false;
     }
+    out << filename << " loaded successfully!" << endl;
 
-    // Convert to uppercase for case-insensitive search
-    string searchNumber = toUpperCase(trimmedCourse);
+    vector<ParsedCatalogFile> parsedFiles(1);
+    ParsedCatalogFile& parsed = parsedFiles[0];
+    parsed.filename = filename;
+    parsed.opened = true;
+    string line;
+    int lineNumber = 0;
+    while (file.getline(line)) {
+        lineNumber++;
+        if (lineNumber % SERVER_CHUNK_LINES == 0) {
+            co_await YieldToExecutor{};
+        }
+        if (line.find_first_not_of(" \t\r\n") == string::npos) {
+            continue;
+        }
 
-    // Search for the course
-    Course* course = hashTable.search(searchNumber);
-    if (course == nullptr) {
-        cout << "Error: Course '" << trimmedCourse << "' not found. Please enter a valid course number." << endl;
-        return;
+        Course course;
+        if (!parseCourseLine(line, course)) {
+            out << "Error: Line " << lineNumber << " - Invalid format (missing course number or title)" << endl;
+            out << "Line: " << line << endl;
+            co_return false;
+        }
+        parsed.courses.push_back(std::move(course));
+        parsed.lineNumbers.push_back(lineNumber);
+    }
+    if (!file.error().empty()) {
+        out << "Error: " << filename << ": " << file.error() << endl;
+        co_return false;
     }
 
-    // Print course information
-    cout << course->courseNumber << ", " << course->courseTitle << endl;
+    if (!validateCatalog(parsedFiles, out, out)) {
+        co_return false;
+    }
 
-    // Print prerequisites if they exist
-    if (course->prerequisites.empty()) {
-        cout << "Prerequisites: None" << endl;
-    } else {
-        cout << "Prerequisites: ";
-        for (size_t i = 0; i < course->prerequisites.size(); ++i) {
-            cout << course->prerequisites[i];
-            if (i < course->prerequisites.size() - 1) {
-                cout << ", ";
-            }
+    vector<Course>& tempCourses = parsed.courses;
+    HashTable freshTable;
+    freshTable.reserve(tempCourses.size());
+    for (size_t i = 0; i < tempCourses.size(); ++i) {
+        freshTable.insert(std::move(tempCourses[i]));
+        if ((i + 1) % SERVER_CHUNK_LINES == 0) {
+            co_await YieldToExecutor{};
         }
-        cout << endl;
     }
 
+    // Suspended listings still point into the old table
+    CatalogWriteIntent intent(access);
+    while (access.activeReaders > 0) {
+        co_await YieldToExecutor{};
+    }
+    hashTable.swap(freshTable);
+    openJournalForLoad(journal, {filename}, hashTable, out);
+
     // End timing
     auto endTime = high_resolution_clock::now();
     clock_t endTicks = clock();
@@ -481,170 +7698,408 @@ void printCourseInformation(HashTable& hashTable, const string& courseNumber) {
     double seconds = duration.count() / 1000000.0;
     clock_t ticks = endTicks - startTicks;
 
-    cout << "Time to print: " << ticks << " clock ticks" << endl;
-    cout << "Time to print: " << fixed << setprecision(6) << seconds << " seconds" << endl;
+    out << tempCourses.size() << " courses loaded." << endl;
+    out << "Time to load: " << ticks << " clock ticks" << endl;
+    out << "Time to load: " << fixed << setprecision(6) << seconds << " seconds" << endl;
+    co_return true;
 }
 
 /**
- * Add a new course to the system
+ * Create the coroutine that will answer one request
+ * LIST, LOAD and EXPORT are long-running and yield between chunks; changes (ADD,
+ * REMOVE, EDIT, BULKADD, UNDO) wait until no listing is suspended mid-iteration; everything else
+ * completes on its first resume
+ * @param request The request line without its trailing newline
  * @param hashTable Reference to the hash table containing courses
+ * @param out Stream for the response body
+ * @param access Reader/writer bookkeeping for the catalog
+ * @param closeConnection Set to true when the client asked to disconnect
+ * @return The (not yet started) request coroutine
  */
-void addCourse(HashTable& hashTable) {
-    // Start timing
-    auto startTime = high_resolution_clock::now();
-    clock_t startTicks = clock();
+RequestTask createServerTask(const string& request, HashTable& hashTable, ostream& out, CatalogAccess& access,
+                             CourseJournal& journal, bool& closeConnection) {
+    string command;
+    string argument;
+    splitServerRequest(request, command, argument);
 
-    Course newCourse;
-    string input;
+    if (command == "LIST") {
+        return streamCourseList(hashTable, out, access);
+    }
+    if (command == "LOAD") {
+        return reloadCatalog(argument, hashTable, out, access, journal);
+    }
+    if (command == "EXPORT") {
+        return streamCatalogExport(argument, hashTable, out, access, journal);
+    }
+    if (command == "ADD" || command == "REMOVE" || command == "EDIT" || command == "BULKADD" || command == "UNDO") {
+        return runExclusive(access, [request, &hashTable, &out, &closeConnection, &journal]() {
+            return handleServerRequest(request, hashTable, out, closeConnection, &journal);
+        });
+    }
+    return completedRequest(handleServerRequest(request, hashTable, out, closeConnection));
+}
+
+// Set by SIGINT/SIGTERM to shut the event loop down cleanly
+volatile sig_atomic_t serverStopRequested = 0;
+
+void handleServerStopSignal(int) {
+    serverStopRequested = 1;
+}
+
+/**
+ * Per-client state for the event loop
+ * Requests may be pipelined: they queue in pendingRequests and are
+ * answered one at a time, in order, by activeTask
+ */
+struct ServerConnection {
+    int fd = -1;
+    string inBuffer;
+    string outBuffer;
+    size_t outOffset = 0;
+    bool closeAfterFlush = false;
+    bool inputClosed = false;
+    bool readPaused = false;
+    bool scheduled = false;         // Already in the executor's ready queue
+    deque<string> pendingRequests;  // Received but not yet started
+    RequestTask activeTask;         // Request currently being answered
+    ostringstream responseBody;     // Output of activeTask not yet framed
+    vector<size_t> journaledFrames; // outBuffer offsets of this round's responses to journaled changes
+};
+
+// Stop reading from a client whose unsent responses exceed this many bytes
+const size_t SERVER_MAX_PENDING_OUTPUT = 4 * 1024 * 1024;
+// Stop reading from a client with this many requests queued
+const size_t SERVER_MAX_PENDING_REQUESTS = 4096;
+// Longest request line accepted before the connection is dropped
+const size_t SERVER_MAX_REQUEST_LINE = 64 * 1024;
+
+/**
+ * Write as much pending output as the socket accepts without blocking
+ * @param connection The client connection to flush
+ * @return False if the connection failed and must be closed
+ */
+bool flushServerConnection(ServerConnection& connection) {
+    while (connection.outOffset < connection.outBuffer.size()) {
+        ssize_t written = send(connection.fd, connection.outBuffer.data() + connection.outOffset,
+                               connection.outBuffer.size() - connection.outOffset, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        connection.outOffset += static_cast<size_t>(written);
+    }
+    connection.outBuffer.clear();
+    connection.outOffset = 0;
+    return true;
+}
+
+/**
+ * Queue a framed response: "<status> <bytes>\n" followed by the body
+ * Status is OK or ERR for a final response, MORE for a streamed chunk
+ * @param connection The client connection
+ * @param status The frame status word
+ * @param body The response text
+ */
+void queueServerResponse(ServerConnection& connection, const char* status, const string& body) {
+    connection.outBuffer += status;
+    connection.outBuffer += " " + to_string(body.size()) + "\n";
+    connection.outBuffer += body;
+}
+
+/**
+ * Turn this round's responses to journaled changes into errors after the
+ * group commit failed. They are still unsent: output is only flushed
+ * after the commit.
+ * @param connection The client connection
+ * @param warning Text appended to each response body
+ */
+void failJournaledResponses(ServerConnection& connection, const string& warning) {
+    // Newest first, so the earlier offsets stay valid
+    for (auto it = connection.journaledFrames.rbegin(); it != connection.journaledFrames.rend(); ++it) {
+        size_t lengthStart = connection.outBuffer.find(' ', *it) + 1;
+        size_t headerEnd = connection.outBuffer.find('\n', lengthStart);
+        size_t bodyLength = stoul(connection.outBuffer.substr(lengthStart, headerEnd - lengthStart));
+        string body = connection.outBuffer.substr(headerEnd + 1, bodyLength) + warning;
+        string frame = "ERR " + to_string(body.size()) + "\n" + body;
+        connection.outBuffer.replace(*it, headerEnd + 1 + bodyLength - *it, frame);
+    }
+}
+
+/**
+ * Move every complete request line from the input buffer to the request queue
+ * @param connection The client connection
+ */
+void queueIncomingRequests(ServerConnection& connection) {
+    size_t start = 0;
+    size_t newline;
+    while ((newline = connection.inBuffer.find('\n', start)) != string::npos) {
+        string request = connection.inBuffer.substr(start, newline - start);
+        start = newline + 1;
+        if (!trim(request).empty()) {
+            connection.pendingRequests.push_back(move(request));
+        }
+    }
+    connection.inBuffer.erase(0, start);
+}
+
+/**
+ * Give one connection a turn on the executor
+ * Runs its active request until it yields; requests that finish without
+ * yielding are followed by the next pipelined one, up to a fairness budget
+ * @param connection The client connection
+ * @param hashTable Reference to the hash table containing courses
+ * @param access Reader/writer bookkeeping for the catalog
+ * @return True if the connection still has work and should be rescheduled
+ */
+bool runConnectionTurn(ServerConnection& connection, HashTable& hashTable, CatalogAccess& access, CourseJournal& journal) {
+    for (int budget = SERVER_REQUESTS_PER_TURN; budget > 0; --budget) {
+        if (!connection.activeTask.valid()) {
+            if (connection.pendingRequests.empty() || connection.closeAfterFlush) {
+                return false;
+            }
+            string request = move(connection.pendingRequests.front());
+            connection.pendingRequests.pop_front();
+            connection.activeTask = createServerTask(request, hashTable, connection.responseBody,
+                                                     access, journal, connection.closeAfterFlush);
+        }
+
+        uint64_t recordsBefore = journal.recordsAppended();
+        connection.activeTask.resume();
+        string body = connection.responseBody.str();
+        connection.responseBody.str("");
+
+        if (!connection.activeTask.done()) {
+            // Stream what the handler produced so far
+            if (!body.empty()) {
+                queueServerResponse(connection, "MORE", body);
+            }
+            return true;
+        }
+
+        // Changes are made in a single resume, so the final frame answers for them
+        if (journal.recordsAppended() != recordsBefore) {
+            connection.journaledFrames.push_back(connection.outBuffer.size());
+        }
+        queueServerResponse(connection, connection.activeTask.succeeded() ? "OK" : "ERR", body);
+        connection.activeTask.reset();
+    }
+    return !connection.pendingRequests.empty();
+}
+
+/**
+ * Serve catalog requests over a Unix domain socket until SIGINT/SIGTERM
+ * A single thread runs an epoll loop for I/O and a round-robin executor
+ * for request coroutines, so long listings and reloads are interleaved
+ * with short lookups instead of blocking them
+ * @param hashTable Reference to the (already loaded) hash table
+ * @param socketPath Filesystem path of the listening socket
+ * @return Process exit status
+ */
+int runCourseServer(HashTable& hashTable, const string& socketPath, CourseJournal& journal) {
+    int listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        cerr << "Error: Could not create socket: " << strerror(errno) << endl;
+        return 1;
+    }
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        cerr << "Error: Socket path '" << socketPath << "' is too long" << endl;
+        close(listenFd);
+        return 1;
+    }
+    strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+    unlink(socketPath.c_str());
+
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(listenFd, SOMAXCONN) < 0) {
+        cerr << "Error: Could not listen on '" << socketPath << "': " << strerror(errno) << endl;
+        close(listenFd);
+        return 1;
+    }
+
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event listenEvent{};
+    listenEvent.events = EPOLLIN;
+    listenEvent.data.fd = listenFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &listenEvent);
+
+    // No SA_RESTART, so epoll_wait returns EINTR and the loop can exit
+    struct sigaction stopAction{};
+    stopAction.sa_handler = handleServerStopSignal;
+    sigaction(SIGINT, &stopAction, nullptr);
+    sigaction(SIGTERM, &stopAction, nullptr);
+    signal(SIGPIPE, SIG_IGN);
+
+    cout << "Serving course requests on " << socketPath << " (Ctrl+C to stop)" << endl;
+
+    CatalogAccess access;
+    vector<unique_ptr<ServerConnection>> connections; // Indexed by file descriptor
+    deque<int> readyQueue;                            // Connections with a runnable request
+    vector<int> roundConnections;                     // Connections that ran in the current round
+    vector<epoll_event> events(256);
+    char readBuffer[64 * 1024];
+
+    auto schedule = [&](ServerConnection& connection) {
+        if (!connection.scheduled && (connection.activeTask.valid() || !connection.pendingRequests.empty())) {
+            connection.scheduled = true;
+            readyQueue.push_back(connection.fd);
+        }
+    };
+
+    // Re-arm a client for reading and/or writing to match its buffered state
+    auto updateInterest = [&](ServerConnection& connection) {
+        connection.readPaused = connection.outBuffer.size() > SERVER_MAX_PENDING_OUTPUT ||
+                                connection.pendingRequests.size() > SERVER_MAX_PENDING_REQUESTS;
+        epoll_event event{};
+        event.data.fd = connection.fd;
+        if (!connection.readPaused && !connection.inputClosed) {
+            event.events |= EPOLLIN | EPOLLRDHUP;
+        }
+        if (!connection.outBuffer.empty()) {
+            event.events |= EPOLLOUT;
+        }
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+    };
+
+    // Flush output and close the connection once it has nothing left to do
+    // @return False if the connection was closed
+    auto settleConnection = [&](int fd) {
+        ServerConnection& connection = *connections[fd];
+        bool idle = !connection.activeTask.valid() &&
+                    (connection.pendingRequests.empty() || connection.closeAfterFlush);
+        bool finished = (connection.inputClosed || connection.closeAfterFlush) && idle;
+        if (!flushServerConnection(connection) || (finished && connection.outBuffer.empty())) {
+            epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+            close(fd);
+            connections[fd].reset();
+            return false;
+        }
+        updateInterest(connection);
+        return true;
+    };
+
+    while (!serverStopRequested) {
+        // Poll without blocking while requests are waiting for the executor
+        int ready = epoll_wait(epollFd, events.data(), static_cast<int>(events.size()), readyQueue.empty() ? -1 : 0);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            cerr << "Error: epoll_wait failed: " << strerror(errno) << endl;
+            break;
+        }
 
-    // Get course number
-    cout << "Enter course number (e.g., CSCI300): ";
-    getline(cin, input);
-    newCourse.courseNumber = toUpperCase(trim(input));
+        for (int e = 0; e < ready; ++e) {
+            int fd = events[e].data.fd;
 
-    // Validate course number is not empty
-    if (newCourse.courseNumber.empty()) {
-        cout << "Error: Course number cannot be empty." << endl;
-        return;
-    }
+            if (fd == listenFd) {
+                // Accept every pending client
+                int clientFd;
+                while ((clientFd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+                    if (static_cast<size_t>(clientFd) >= connections.size()) {
+                        connections.resize(clientFd + 1);
+                    }
+                    connections[clientFd] = make_unique<ServerConnection>();
+                    connections[clientFd]->fd = clientFd;
+                    epoll_event clientEvent{};
+                    clientEvent.events = EPOLLIN | EPOLLRDHUP;
+                    clientEvent.data.fd = clientFd;
+                    epoll_ctl(epollFd, EPOLL_CTL_ADD, clientFd, &clientEvent);
+                }
+                continue;
+            }
 
-    // Check if course already exists
-    if (hashTable.search(newCourse.courseNumber) != nullptr) {
-        cout << "Error: Course " << newCourse.courseNumber << " already exists." << endl;
-        return;
-    }
+            if (!connections[fd]) {
+                continue;
+            }
+            ServerConnection& connection = *connections[fd];
 
-    // Get course title
-    cout << "Enter course title: ";
-    getline(cin, newCourse.courseTitle);
+            if (!connection.inputClosed && (events[e].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))) {
+                // Drain the socket, then queue every complete request
+                while (true) {
+                    ssize_t received = recv(fd, readBuffer, sizeof(readBuffer), 0);
+                    if (received > 0) {
+                        connection.inBuffer.append(readBuffer, static_cast<size_t>(received));
+                        continue;
+                    }
+                    if (received < 0 && errno == EINTR) {
+                        continue;
+                    }
+                    if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+                        connection.inputClosed = true;
+                    }
+                    break;
+                }
 
-    // Validate course title is not empty
-    if (newCourse.courseTitle.empty()) {
-        cout << "Error: Course title cannot be empty." << endl;
-        return;
-    }
+                queueIncomingRequests(connection);
+                if (connection.inBuffer.size() > SERVER_MAX_REQUEST_LINE) {
+                    connection.pendingRequests.clear();
+                    queueServerResponse(connection, "ERR", "Error: Request line too long.\n");
+                    connection.closeAfterFlush = true;
+                }
+            }
 
-    // Get prerequisites
-    cout << "Enter prerequisites (comma-separated, leave blank or type 'none' if none): ";
-    getline(cin, input);
+            if (settleConnection(fd)) {
+                schedule(connection);
+            }
+        }
 
-    string prereqInput = toUpperCase(trim(input));
-    if (!prereqInput.empty() && prereqInput != "NONE") {
-        vector<string> prereqs = split(input, ',');
-        // Validate each prerequisite exists in the hash table
-        // If a prerequisite does not exist, show an error and do not add the course
-        for (const auto& prereq : prereqs) {
-            string prereqNumber = toUpperCase(trim(prereq));
-            if (prereqNumber == "NONE" || prereqNumber.empty()) {
+        // Executor: one turn for each connection that was ready at the start of this round
+        roundConnections.clear();
+        for (size_t turns = readyQueue.size(); turns > 0; --turns) {
+            int fd = readyQueue.front();
+            readyQueue.pop_front();
+            if (static_cast<size_t>(fd) >= connections.size() || !connections[fd]) {
                 continue;
             }
-            if (hashTable.search(prereqNumber) == nullptr) {
-                cout << "Error: Prerequisite '" << prereqNumber << "' does not exist in the course list." << endl;
-                cout << "Course not added. Please add prerequisites first." << endl;
-                return;
+            ServerConnection& connection = *connections[fd];
+            connection.scheduled = false;
+
+            // A client that is not reading its responses gets no more turns until it drains
+            if (connection.outBuffer.size() <= SERVER_MAX_PENDING_OUTPUT) {
+                runConnectionTurn(connection, hashTable, access, journal);
             }
-            newCourse.prerequisites.push_back(prereqNumber);
+            roundConnections.push_back(fd);
         }
-    }
 
-    // Add the course to the hash table
-    hashTable.insert(newCourse);
-    cout << "Course '" << newCourse.courseNumber << "' added successfully!" << endl;
-}
-/**
- * Remove a course from the system
- * @param hashTable Reference to the hash table containing courses
- */
-void removeCourse(HashTable& hashTable) {
-    // Start timing
-    auto startTime = high_resolution_clock::now();
-    clock_t startTicks = clock();
-    
-    string courseNumber;
-    
-    cout << "Enter course number to remove: ";
-    getline(cin, courseNumber);
-    
-    string searchNumber = toUpperCase(trim(courseNumber));
-    
-    // Validate input
-    if (searchNumber.empty()) {
-        cout << "Error: Course number cannot be empty." << endl;
-        return;
-    }
-    
-    // Check if course exists
-    Course* course = hashTable.search(searchNumber);
-    if (course == nullptr) {
-        cout << "Error: Course " << courseNumber << " not found." << endl;
-        return;
-    }
-    
-    // Check if this course is a prerequisite for other courses
-    vector<Course> allCourses = hashTable.getAllCourses();
-    vector<string> dependentCourses;
-    
-    for (const auto& c : allCourses) {
-        for (const auto& prereq : c.prerequisites) {
-            if (prereq == searchNumber) {
-                dependentCourses.push_back(c.courseNumber);
-                break;
+        // Group commit: one fsync covers every change made this round, and no
+        // response for those changes is sent before it is durable
+        if (!journal.commit()) {
+            ostringstream warning;
+            journal.reportFailure(warning);
+            cerr << warning.str();
+            for (int fd : roundConnections) {
+                failJournaledResponses(*connections[fd], warning.str());
             }
         }
-    }
-    
-    // Warn if course is a prerequisite
-    if (!dependentCourses.empty()) {
-        cout << endl;
-        cout << "WARNING: " << searchNumber << " is a prerequisite for:" << endl;
-        for (const auto& dep : dependentCourses) {
-            cout << "  - " << dep << endl;
-        }
-        cout << endl;
-        cout << "Removing this course will affect these courses." << endl;
-        cout << "Are you sure you want to continue? (yes/no): ";
-        
-        string confirmation;
-        getline(cin, confirmation);
-        
-        if (toUpperCase(trim(confirmation)) != "YES") {
-            cout << "Course removal cancelled." << endl;
-            return;
+        for (int fd : roundConnections) {
+            ServerConnection& connection = *connections[fd];
+            connection.journaledFrames.clear();
+            if (settleConnection(fd) && connection.outBuffer.size() <= SERVER_MAX_PENDING_OUTPUT) {
+                schedule(connection);
+            }
         }
     }
-    
-    // Remove the course
-    bool removed = hashTable.remove(searchNumber);
-    
-    // End timing
-    auto endTime = high_resolution_clock::now();
-    clock_t endTicks = clock();
-    
-    // Calculate elapsed time
-    auto duration = duration_cast<microseconds>(endTime - startTime);
-    double seconds = duration.count() / 1000000.0;
-    clock_t ticks = endTicks - startTicks;
-    
-    if (removed) {
-        removePrerequisiteFromAllCourses(hashTable, searchNumber);
-        cout << endl;
-        cout << "Course " << searchNumber << " removed successfully." << endl;
-        cout << "WARNING: All prerequisites referencing this course will be automatically removed from other courses." << endl;
-        cout << "Do you want to proceed with prerequisite cleanup? (yes/no): ";
-        string cleanupConfirm;
-        getline(cin, cleanupConfirm);
-        if (toUpperCase(trim(cleanupConfirm)) == "YES") {
-            removePrerequisiteFromAllCourses(hashTable, searchNumber);
-            cout << "Prerequisite cleanup completed." << endl;
-        } else {
-            cout << "Prerequisite cleanup skipped. Some courses may still reference this course as a prerequisite." << endl;
+
+    // Destroying the connections also destroys any suspended request coroutines
+    for (auto& connection : connections) {
+        if (connection) {
+            close(connection->fd);
         }
-        cout << "Time to remove: " << ticks << " clock ticks" << endl;
-        cout << "Time to remove: " << fixed << setprecision(6) << seconds << " seconds" << endl;
-    } else {
-        cout << "Error: Failed to remove course." << endl;
     }
+    connections.clear();
+    close(epollFd);
+    close(listenFd);
+    unlink(socketPath.c_str());
+    cout << "Server stopped." << endl;
+    return 0;
 }
+
+#endif
+
 // Display the main menu and get user choice
 void displayMenu() {
     cout << "1. Load Data File." << endl;
@@ -652,6 +8107,15 @@ void displayMenu() {
     cout << "3. Print Course." << endl;
     cout << "4. Add Course." << endl;
     cout << "5. Remove Course." << endl;
+    cout << "6. Export Course List." << endl;
+    cout << "7. Undo Last Change." << endl;
+    cout << "8. Bulk Add Courses from File." << endl;
+    cout << "10. Edit Course." << endl;
+    cout << "11. Freeze Catalog for Fast Lookups." << endl;
+    cout << "12. Check Course Eligibility." << endl;
+    cout << "13. Show Catalog Statistics." << endl;
+    cout << "14. List Courses by Department." << endl;
+    cout << "15. Show Prerequisite Chains." << endl;
     cout << "9. Exit." << endl;
     cout << endl;
     cout << "What would you like to do? ";
@@ -661,16 +8125,190 @@ void displayMenu() {
 // Main Function
 //============================================================================= 
 
+// Print the command-line modes
+void printUsage(const char* program) {
+    cout << "Usage:" << endl;
+    cout << "  " << program << "                               Interactive menu" << endl;
+    cout << "  " << program << " --serve <file.csv> [socket]   Serve the catalog over a Unix domain socket" << endl;
+    cout << "  " << program << " --generate <count> <file.csv> Write a synthetic catalog for load testing" << endl;
+    cout << "  " << program << " --embed <file.csv> <header.h>  Write a catalog header for the minimal kiosk build" << endl;
+    cout << "  " << program << " --stats <file.csv>            Report bucket occupancy, chain lengths and memory use" << endl;
+    cout << "  " << program << " --chains <file.csv> [course]  Report the longest prerequisite chains and critical path" << endl;
+    cout << "  " << program << " --validate <file.csv> [...]   Report every error in the files without loading them" << endl;
+    cout << "  " << program << " --publish <file.csv> [name]   Publish the catalog to shared memory (again to republish)" << endl;
+    cout << "  " << program << " --attach [name]               Look up courses in a published catalog without loading it" << endl;
+    cout << "  " << program << " --unpublish [name]            Remove a published catalog from shared memory" << endl;
+    cout << "  " << program << " --bench lookup <file.csv> [count]  Time lookups: chained table vs frozen index" << endl;
+    cout << "  " << program << " --eligibility <file.csv> <transcripts.csv> <results.csv> [threads]" << endl;
+    cout << "      Batch eligibility: one line per student, \"student,completed,...\" in, \"student,eligible,...\" out" << endl;
+    cout << "  " << program << " --bench sort <file.csv> [rounds]  Time listing sorts: std::sort vs radix sort" << endl;
+    cout << "  " << program << " --bench insert <file.csv>  Time (and count allocations of) copy vs move inserts" << endl;
+    cout << "  " << program << " --bench eligibility <file.csv> [transcripts]  Time eligibility checks: per-course vs bit matrix" << endl;
+    cout << "  " << program << " --lazy-titles [mode ...]      Load titles lazily from the mapped file (before any mode)" << endl;
+}
+
+/**
+ * Run a non-interactive mode selected on the command line
+ * @param args Command-line arguments after the program name
+ * @param program The program name, for usage messages
+ * @return Process exit status
+ */
+int runCommandLineMode(const vector<string>& args, const char* program) {
+    if (args[0] == "--generate" && args.size() == 3) {
+        if (args[1].empty() || args[1].find_first_not_of("0123456789") != string::npos) {
+            cerr << "Error: Course count must be a positive number." << endl;
+            return 1;
+        }
+        return generateSyntheticCatalog(stoul(args[1]), args[2]) ? 0 : 1;
+    }
+
+    if (args[0] == "--bench" && args.size() >= 3 && args[1] == "lookup") {
+        size_t lookupCount = 1000000;
+        if (args.size() == 4) {
+            if (args[3].empty() || args[3].find_first_not_of("0123456789") != string::npos) {
+                cerr << "Error: Lookup count must be a positive number." << endl;
+                return 1;
+            }
+            lookupCount = stoul(args[3]);
+        }
+        return runLookupBenchmark(args[2], max<size_t>(1, lookupCount));
+    }
+
+    if (args[0] == "--eligibility" && (args.size() == 4 || args.size() == 5)) {
+        unsigned int threadCount = max(1u, thread::hardware_concurrency());
+        if (args.size() == 5) {
+            if (args[4].empty() || args[4].find_first_not_of("0123456789") != string::npos) {
+                cerr << "Error: Thread count must be a positive number." << endl;
+                return 1;
+            }
+            threadCount = static_cast<unsigned int>(stoul(args[4]));
+        }
+        HashTable courseHashTable;
+        if (!loadCourseData(args[1], courseHashTable)) {
+            return 1;
+        }
+        return evaluateTranscriptBatch(courseHashTable, args[2], args[3], threadCount) ? 0 : 1;
+    }
+
+    if (args[0] == "--bench" && args.size() >= 3 && args[1] == "sort") {
+        size_t rounds = 3;
+        if (args.size() == 4) {
+            if (args[3].empty() || args[3].find_first_not_of("0123456789") != string::npos) {
+                cerr << "Error: Round count must be a positive number." << endl;
+                return 1;
+            }
+            rounds = stoul(args[3]);
+        }
+        return runSortBenchmark(args[2], max<size_t>(1, rounds));
+    }
+
+    if (args[0] == "--validate" && args.size() >= 2) {
+        vector<string> filenames(args.begin() + 1, args.end());
+        return printCatalogValidation(filenames, max(1u, thread::hardware_concurrency())) ? 0 : 1;
+    }
+
+    if (args[0] == "--stats" && args.size() == 2) {
+        HashTable courseHashTable;
+        ostringstream loadLog;
+        if (!loadCourseData(args[1], courseHashTable, loadLog, cerr)) {
+            return 1;
+        }
+        return printCatalogStats(courseHashTable) ? 0 : 1;
+    }
+
+    if (args[0] == "--publish" && (args.size() == 2 || args.size() == 3)) {
+        HashTable courseHashTable;
+        if (!loadCourseData(args[1], courseHashTable)) {
+            return 1;
+        }
+        return publishSharedCatalog(courseHashTable, args.size() == 3 ? args[2] : DEFAULT_SHARED_CATALOG_NAME) ? 0 : 1;
+    }
+
+    if (args[0] == "--attach" && args.size() <= 2) {
+        return runSharedCatalogSession(args.size() == 2 ? args[1] : DEFAULT_SHARED_CATALOG_NAME);
+    }
+
+    if (args[0] == "--unpublish" && args.size() <= 2) {
+        return unpublishSharedCatalog(args.size() == 2 ? args[1] : DEFAULT_SHARED_CATALOG_NAME) ? 0 : 1;
+    }
+
+    if (args[0] == "--chains" && (args.size() == 2 || args.size() == 3)) {
+        HashTable courseHashTable;
+        ostringstream loadLog;
+        if (!loadCourseData(args[1], courseHashTable, loadLog, cerr)) {
+            return 1;
+        }
+        return printPrerequisiteChains(courseHashTable, args.size() == 3 ? args[2] : "") ? 0 : 1;
+    }
+
+    if (args[0] == "--bench" && args.size() == 3 && args[1] == "insert") {
+        return runInsertBenchmark(args[2]);
+    }
+
+    if (args[0] == "--bench" && args.size() >= 3 && args[1] == "eligibility") {
+        size_t transcriptCount = 200;
+        if (args.size() == 4) {
+            if (args[3].empty() || args[3].find_first_not_of("0123456789") != string::npos) {
+                cerr << "Error: Transcript count must be a positive number." << endl;
+                return 1;
+            }
+            transcriptCount = stoul(args[3]);
+        }
+        return runEligibilityBenchmark(args[2], max<size_t>(1, transcriptCount));
+    }
+
+    if (args[0] == "--embed" && args.size() == 3) {
+        // Loading first gives the header the same validation as option 1
+        HashTable courseHashTable;
+        if (!loadCourseData(args[1], courseHashTable)) {
+            return 1;
+        }
+        return writeEmbeddedCatalogHeader(courseHashTable, filesystem::path(args[1]).filename().string(), args[2]) ? 0 : 1;
+    }
+
+    if (args[0] == "--serve" && (args.size() == 2 || args.size() == 3)) {
+#ifdef COURSE_SERVER_AVAILABLE
+        // Load once; every connected client shares this catalog
+        HashTable courseHashTable;
+        if (!loadCourseData(args[1], courseHashTable)) {
+            return 1;
+        }
+        CourseJournal journal;
+        openJournalForLoad(journal, {args[1]}, courseHashTable);
+        return runCourseServer(courseHashTable, args.size() == 3 ? args[2] : DEFAULT_SOCKET_PATH, journal);
+#else
+        cerr << "Error: Server mode requires Linux and a C++20 build (-std=c++20)." << endl;
+        return 1;
+#endif
+    }
+
+    printUsage(program);
+    return args[0] == "--help" ? 0 : 1;
+}
+
 // Entry point of the program
-int main() {
+int main(int argc, char* argv[]) {
+    vector<string> args(argv + 1, argv + argc);
+    // --lazy-titles may come before any mode, including the interactive menu
+    if (!args.empty() && args[0] == "--lazy-titles") {
+        lazyTitleLoading = true;
+        args.erase(args.begin());
+    }
+    if (!args.empty()) {
+        return runCommandLineMode(args, argv[0]);
+    }
+
     // Create hash table to store courses
     HashTable courseHashTable;
 
     // Flag to track if data is loaded
     bool dataLoaded = false;
 
+    // Write-ahead journal of changes to the loaded files
+    CourseJournal journal;
+
     int choice =0;
-    string filename;
+    vector<string> filenames;
     string courseNumber;
 
     cout << "Welcome to the ABCU Course Management System!" << endl;
@@ -706,18 +8344,24 @@ int main() {
                         cout << (i + 1) << ". " << csvFiles[i] << endl;
                     }
                     cout << endl;
-                    cout << "Enter the number of the file to load: ";
-                    size_t fileChoice = 0;
-                    cin >> fileChoice;
-                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
-                    if (fileChoice < 1 || fileChoice > csvFiles.size()) {
+                    cout << "Enter the number of the file to load (several numbers separated by commas, or 'all' to merge files): ";
+                    string selection;
+                    getline(cin, selection);
+                    vector<size_t> fileChoices;
+                    if (!parseFileSelection(selection, csvFiles.size(), fileChoices)) {
                         cout << "Invalid selection." << endl;
                         break;
                     }
-                    filename = csvFiles[fileChoice - 1];
+                    filenames.clear();
+                    for (size_t fileChoice : fileChoices) {
+                        filenames.push_back(csvFiles[fileChoice - 1]);
+                    }
                 }
-                if (loadCourseData(filename, courseHashTable)) {
+                // A load replaces the catalog, so the journal opened for these
+                // files covers every course; a failed load changes nothing
+                if (loadCourseFiles(filenames, courseHashTable)) {
                     dataLoaded = true;
+                    openJournalForLoad(journal, filenames, courseHashTable);
                 }
                 cout << endl;
                 break;
@@ -748,7 +8392,11 @@ int main() {
                 if (!dataLoaded) {
                     cout << "Please load data first (Option 1)." << endl;
                 } else {
-                    addCourse(courseHashTable);
+                    journal.beginOperation();
+                    addCourse(courseHashTable, &journal);
+                    if (!journal.commit()) {
+                        journal.reportFailure(cout);
+                    }
                     cout << endl;
                 }
                 break;
@@ -758,11 +8406,118 @@ int main() {
                 if (!dataLoaded) {
                     cout << "Please load data first (Option 1)." << endl;
                 } else {
-                    removeCourse(courseHashTable);
+                    journal.beginOperation();
+                    removeCourse(courseHashTable, &journal);
+                    if (!journal.commit()) {
+                        journal.reportFailure(cout);
+                    }
                     cout << endl;
                 }
                 break;
                 
+            case 6:
+                // Export the catalog to CSV or JSON Lines
+                if (!dataLoaded) {
+                    cout << "Please load data first (Option 1)." << endl;
+                } else {
+                    exportCourses(courseHashTable, &journal);
+                    cout << endl;
+                }
+                break;
+
+            case 7:
+                // Revert the most recent add or remove
+                if (!dataLoaded) {
+                    cout << "Please load data first (Option 1)." << endl;
+                } else if (!journal.isOpen()) {
+                    cout << "Undo is unavailable because the journal is not open." << endl;
+                } else {
+                    journal.undoLast(courseHashTable, cout);
+                    cout << endl;
+                }
+                break;
+
+            case 8:
+                // Add every course in a CSV file as one operation
+                if (!dataLoaded) {
+                    cout << "Please load data first (Option 1)." << endl;
+                } else {
+                    journal.beginOperation();
+                    bulkAddFromFile(courseHashTable, &journal);
+                    if (!journal.commit()) {
+                        journal.reportFailure(cout);
+                    }
+                    cout << endl;
+                }
+                break;
+
+            case 10:
+                // Change a course's title or prerequisites in place
+                if (!dataLoaded) {
+                    cout << "Please load data first (Option 1)." << endl;
+                } else {
+                    journal.beginOperation();
+                    editCourse(courseHashTable, &journal);
+                    if (!journal.commit()) {
+                        journal.reportFailure(cout);
+                    }
+                    cout << endl;
+                }
+                break;
+
+            case 11:
+                // Build the read-only perfect hash index
+                if (!dataLoaded) {
+                    cout << "Please load data first (Option 1)." << endl;
+                } else {
+                    freezeCatalog(courseHashTable);
+                    cout << endl;
+                }
+                break;
+
+            case 12:
+                // List the courses a student can take next
+                if (!dataLoaded) {
+                    cout << "Please load data first (Option 1)." << endl;
+                } else {
+                    checkEligibility(courseHashTable);
+                    cout << endl;
+                }
+                break;
+
+            case 13:
+                // Report bucket occupancy, chain lengths and memory use
+                if (!dataLoaded) {
+                    cout << "Please load data first (Option 1)." << endl;
+                } else {
+                    printCatalogStats(courseHashTable);
+                    cout << endl;
+                }
+                break;
+
+            case 14:
+                // List a department, or a level range within one, in order
+                if (!dataLoaded) {
+                    cout << "Please load data first (Option 1)." << endl;
+                } else {
+                    cout << "Enter a department (e.g. CSCI) or a level range (e.g. CSCI 300-399), or leave blank to list departments: ";
+                    string query;
+                    getline(cin, query);
+                    printDepartmentCourses(courseHashTable, query);
+                    cout << endl;
+                }
+                break;
+
+            case 15:
+                // Earliest terms, longest chains and the critical path
+                if (!dataLoaded) {
+                    cout << "Please load data first (Option 1)." << endl;
+                } else {
+                    showPrerequisiteChains(courseHashTable);
+                    cout << endl;
+                }
+                break;
+
             case 9:
                 // Exit the program
                 cout << "Thank you for using the ABCU Course Management System. Goodbye!" << endl;